@@ -0,0 +1,103 @@
+#include<random>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "eop.h"
+
+// The predicate holds for about state.range(1) percent of the elements
+static std::vector<int> compaction_input(int n)
+{
+  std::mt19937 g(n);
+  std::uniform_int_distribution<int> d(0, 99);
+  std::vector<int> v(n);
+  for (int& a : v) a = d(g);
+  return v;
+}
+
+struct compaction_less_than
+{
+  int k;
+  bool operator()(int a) const { return a < k; }
+};
+
+static void BM_copy_if_elementwise(benchmark::State& state) {
+  // The generic algorithm, through an iterator the contiguous overloads
+  // don't match
+  std::vector<int> input = compaction_input(state.range(0));
+  std::vector<int> output(input.size());
+  compaction_less_than p { int(state.range(1)) };
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::copy_if(input.begin(), input.end(), output.begin(), p));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_copy_if_elementwise)->ArgsProduct({ { 1 << 14, 1 << 20 }, { 1, 10, 50, 90, 99 } });
+
+static void BM_copy_if_contiguous(benchmark::State& state) {
+  std::vector<int> input = compaction_input(state.range(0));
+  std::vector<int> output(input.size());
+  compaction_less_than p { int(state.range(1)) };
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::copy_if(input.data(), input.data() + input.size(), output.data(), p));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_copy_if_contiguous)->ArgsProduct({ { 1 << 14, 1 << 20 }, { 1, 10, 50, 90, 99 } });
+
+static void BM_partition_copy_n_elementwise(benchmark::State& state) {
+  std::vector<int> input = compaction_input(state.range(0));
+  std::vector<int> output_f(input.size());
+  std::vector<int> output_t(input.size());
+  compaction_less_than p { int(state.range(1)) };
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::partition_copy_n(input.begin(), int(input.size()),
+                                                   output_f.begin(), output_t.begin(), p));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_partition_copy_n_elementwise)->ArgsProduct({ { 1 << 14, 1 << 20 }, { 1, 10, 50, 90, 99 } });
+
+static void BM_partition_copy_n_contiguous(benchmark::State& state) {
+  std::vector<int> input = compaction_input(state.range(0));
+  std::vector<int> output_f(input.size());
+  std::vector<int> output_t(input.size());
+  compaction_less_than p { int(state.range(1)) };
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::partition_copy_n(input.data(), int(input.size()),
+                                                   output_f.data(), output_t.data(), p));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_partition_copy_n_contiguous)->ArgsProduct({ { 1 << 14, 1 << 20 }, { 1, 10, 50, 90, 99 } });
+
+static void BM_copy_if_blocked(benchmark::State& state) {
+  // The blocks whether or not copy_if takes them by default
+  std::vector<int> input = compaction_input(state.range(0));
+  std::vector<int> output(input.size());
+  eop::predicate_source<int*, compaction_less_than> p(compaction_less_than{ int(state.range(1)) });
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::copy_select_blocked(input.data(), input.data() + input.size(), output.data(), p));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_copy_if_blocked)->ArgsProduct({ { 1 << 14, 1 << 20 }, { 1, 10, 50, 90, 99 } });
+
+static void BM_partition_copy_n_blocked(benchmark::State& state) {
+  // The blocks whether or not partition_copy_n takes them by default
+  std::vector<int> input = compaction_input(state.range(0));
+  std::vector<int> output_f(input.size());
+  std::vector<int> output_t(input.size());
+  eop::predicate_source<int*, compaction_less_than> p(compaction_less_than{ int(state.range(1)) });
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::split_copy_n_blocked(input.data(), int(input.size()),
+                                                       output_f.data(), output_t.data(), p));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_partition_copy_n_blocked)->ArgsProduct({ { 1 << 14, 1 << 20 }, { 1, 10, 50, 90, 99 } });
@@ -0,0 +1,107 @@
+#include<cstdint>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "eop.h"
+
+// Ranges that differ only in their last element, the worst case for an
+// early exit; the iterator versions take the element by element path and
+// the pointer versions the contiguous one
+static const std::size_t range_bytes = std::size_t(1) << 26;
+
+template<typename T>
+struct range_pair
+{
+  std::vector<T> x;
+  std::vector<T> y;
+  range_pair() : x(range_bytes / sizeof(T), T(1)), y(x) { y.back() = T(2); }
+};
+
+static void BM_find_mismatch_int_iterator(benchmark::State& state) {
+  range_pair<int> p;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::find_mismatch(p.x.begin(), p.x.end(), p.y.begin(), p.y.end(), eop::equal<int>()));
+  }
+  state.SetBytesProcessed(state.iterations() * range_bytes);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_find_mismatch_int_iterator)->Unit(benchmark::kMillisecond);
+
+static void BM_find_mismatch_int_contiguous(benchmark::State& state) {
+  range_pair<int> p;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::find_mismatch(p.x.data(), p.x.data() + p.x.size(),
+                                                p.y.data(), p.y.data() + p.y.size(), eop::equal<int>()));
+  }
+  state.SetBytesProcessed(state.iterations() * range_bytes);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_find_mismatch_int_contiguous)->Unit(benchmark::kMillisecond);
+
+static void BM_lexicographical_compare_bytes_iterator(benchmark::State& state) {
+  range_pair<std::uint8_t> p;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::lexicographical_compare(p.x.begin(), p.x.end(), p.y.begin(), p.y.end(),
+                                                          eop::less<std::uint8_t>()));
+  }
+  state.SetBytesProcessed(state.iterations() * range_bytes);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_lexicographical_compare_bytes_iterator)->Unit(benchmark::kMillisecond);
+
+static void BM_lexicographical_compare_bytes_contiguous(benchmark::State& state) {
+  range_pair<std::uint8_t> p;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::lexicographical_compare(p.x.data(), p.x.data() + p.x.size(),
+                                                          p.y.data(), p.y.data() + p.y.size(),
+                                                          eop::less<std::uint8_t>()));
+  }
+  state.SetBytesProcessed(state.iterations() * range_bytes);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_lexicographical_compare_bytes_contiguous)->Unit(benchmark::kMillisecond);
+
+static void BM_lexicographical_compare_int_contiguous(benchmark::State& state) {
+  range_pair<int> p;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::lexicographical_compare(p.x.data(), p.x.data() + p.x.size(),
+                                                          p.y.data(), p.y.data() + p.y.size(),
+                                                          eop::less<int>()));
+  }
+  state.SetBytesProcessed(state.iterations() * range_bytes);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_lexicographical_compare_int_contiguous)->Unit(benchmark::kMillisecond);
+
+static void BM_lexicographical_equal_int_iterator(benchmark::State& state) {
+  range_pair<int> p;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::lexicographical_equal(p.x.begin(), p.x.end(), p.y.begin(), p.y.end()));
+  }
+  state.SetBytesProcessed(state.iterations() * range_bytes);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_lexicographical_equal_int_iterator)->Unit(benchmark::kMillisecond);
+
+static void BM_lexicographical_equal_int_contiguous(benchmark::State& state) {
+  range_pair<int> p;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::lexicographical_equal(p.x.data(), p.x.data() + p.x.size(),
+                                                        p.y.data(), p.y.data() + p.y.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * range_bytes);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_lexicographical_equal_int_contiguous)->Unit(benchmark::kMillisecond);
+
+static void BM_lexicographical_less_int_parallel(benchmark::State& state) {
+  range_pair<int> p;
+  int threads = int(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::lexicographical_less_parallel(p.x.data(), p.x.data() + p.x.size(),
+                                                                p.y.data(), p.y.data() + p.y.size(), threads));
+  }
+  state.SetBytesProcessed(state.iterations() * range_bytes);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_lexicographical_less_int_parallel)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,84 @@
+#include<numeric>
+
+#include "benchmark/benchmark.h"
+#include "coordinate_iterator_adpater.h"
+#include "eop.h"
+#include "project_7_1.h"
+#include "tree.h"
+
+typedef eop::tree_coordinate<long> Coordinate;
+
+// Builds a balanced tree holding the values [f, f + n) in order
+static Coordinate build_balanced(long f, long n, Coordinate p) {
+  if (n == 0) return Coordinate{ 0 };
+  long h = n / 2;
+  Coordinate c = eop::tree_node_construct<long>{}(f + h);
+  eop::set_predecessor(c, p);
+  eop::set_left_successor(c, build_balanced(f, h, c));
+  eop::set_right_successor(c, build_balanced(f + h + 1, n - h - 1, c));
+  return c;
+}
+
+struct balanced_tree
+{
+  Coordinate root;
+  balanced_tree(long n) : root(build_balanced(0, n, Coordinate{ 0 })) {}
+  ~balanced_tree() { eop::bifurcate_erase(root, eop::tree_node_destroy<long>{}); }
+};
+
+static void BM_accumulate_coordinate_iterator(benchmark::State& state) {
+  balanced_tree t(state.range(0));
+  eop::visit order = eop::visit(state.range(1));
+  while (state.KeepRunning()) {
+    long sum = std::accumulate(eop::begin(t.root, order), eop::end(t.root, order), 0l);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_accumulate_coordinate_iterator)
+  ->ArgPair(1<<16, int(eop::visit::pre))->ArgPair(1<<16, int(eop::visit::in))->ArgPair(1<<16, int(eop::visit::post))
+  ->ArgPair(10000000, int(eop::visit::pre))->ArgPair(10000000, int(eop::visit::in))
+  ->ArgPair(10000000, int(eop::visit::post))->Unit(benchmark::kMicrosecond);
+
+// Each step re-derives its position from the coordinate alone
+static void BM_accumulate_successor_c(benchmark::State& state) {
+  balanced_tree t(state.range(0));
+  eop::visit order = eop::visit(state.range(1));
+  while (state.KeepRunning()) {
+    long sum = 0;
+    Coordinate c = eop::advance_to_first(t.root, order, t.root);
+    while (!eop::empty(c)) {
+      sum = sum + eop::source(c);
+      c = eop::successor_c(c, order);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_accumulate_successor_c)
+  ->ArgPair(1<<16, int(eop::visit::pre))->ArgPair(1<<16, int(eop::visit::in))->ArgPair(1<<16, int(eop::visit::post))
+  ->ArgPair(10000000, int(eop::visit::pre))->ArgPair(10000000, int(eop::visit::in))
+  ->ArgPair(10000000, int(eop::visit::post))->Unit(benchmark::kMicrosecond);
+
+struct accumulate_long
+{
+  long sum;
+  void operator()(const long& x) { sum = sum + x; }
+};
+
+static void BM_accumulate_for_each(benchmark::State& state) {
+  balanced_tree t(state.range(0));
+  eop::visit order = eop::visit(state.range(1));
+  while (state.KeepRunning()) {
+    long sum = eop::for_each(t.root, accumulate_long{ 0 }, order).sum;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_accumulate_for_each)
+  ->ArgPair(1<<16, int(eop::visit::pre))->ArgPair(1<<16, int(eop::visit::in))->ArgPair(1<<16, int(eop::visit::post))
+  ->ArgPair(10000000, int(eop::visit::pre))->ArgPair(10000000, int(eop::visit::in))
+  ->ArgPair(10000000, int(eop::visit::post))->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,127 @@
+#include<cstring>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "eop.h"
+
+// Copies of 64 KiB (cache resident), 16 MiB and 256 MiB of ints
+
+static void BM_memcpy(benchmark::State& state) {
+  std::vector<int> input(state.range(0) / sizeof(int));
+  std::vector<int> output(input.size());
+  while (state.KeepRunning()) {
+    std::memcpy(output.data(), input.data(), state.range(0));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_memcpy)->Arg(64<<10)->Arg(16<<20)->Arg(256<<20);
+
+static void BM_copy_n_contiguous(benchmark::State& state) {
+  std::vector<int> input(state.range(0) / sizeof(int));
+  std::vector<int> output(input.size());
+  while (state.KeepRunning()) {
+    eop::copy_n(input.data(), int(input.size()), output.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_copy_n_contiguous)->Arg(64<<10)->Arg(16<<20)->Arg(256<<20);
+
+static void BM_copy_n_streaming(benchmark::State& state) {
+  std::vector<int> input(state.range(0) / sizeof(int));
+  std::vector<int> output(input.size());
+  while (state.KeepRunning()) {
+    eop::copy_n_streaming(input.data(), int(input.size()), output.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_copy_n_streaming)->Arg(64<<10)->Arg(16<<20)->Arg(256<<20);
+
+static void BM_copy_n(benchmark::State& state) {
+  std::vector<int> input(state.range(0) / sizeof(int));
+  std::vector<int> output(input.size());
+  while (state.KeepRunning()) {
+    eop::copy_n(input.begin(), int(input.size()), output.begin());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_copy_n)->Arg(64<<10)->Arg(16<<20)->Arg(256<<20);
+
+static void BM_copy_backward_n_contiguous(benchmark::State& state) {
+  std::vector<int> input(state.range(0) / sizeof(int));
+  std::vector<int> output(input.size());
+  while (state.KeepRunning()) {
+    eop::copy_backward_n(input.data() + input.size(), int(input.size()), output.data() + output.size());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_copy_backward_n_contiguous)->Arg(64<<10)->Arg(16<<20)->Arg(256<<20);
+
+static void BM_copy_backward_n_streaming(benchmark::State& state) {
+  std::vector<int> input(state.range(0) / sizeof(int));
+  std::vector<int> output(input.size());
+  while (state.KeepRunning()) {
+    eop::copy_backward_n_streaming(input.data() + input.size(), int(input.size()), output.data() + output.size());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_copy_backward_n_streaming)->Arg(64<<10)->Arg(16<<20)->Arg(256<<20);
+
+static void BM_copy_backward_n(benchmark::State& state) {
+  std::vector<int> input(state.range(0) / sizeof(int));
+  std::vector<int> output(input.size());
+  while (state.KeepRunning()) {
+    eop::copy_backward_n(input.end(), int(input.size()), output.end());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_copy_backward_n)->Arg(64<<10)->Arg(16<<20)->Arg(256<<20);
+
+static void BM_swap_ranges_n_contiguous(benchmark::State& state) {
+  std::vector<int> x(state.range(0) / sizeof(int));
+  std::vector<int> y(x.size());
+  while (state.KeepRunning()) {
+    eop::swap_ranges_n(x.data(), y.data(), int(x.size()));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 2);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_swap_ranges_n_contiguous)->Arg(64<<10)->Arg(16<<20)->Arg(256<<20);
+
+static void BM_swap_ranges_n_streaming(benchmark::State& state) {
+  std::vector<int> x(state.range(0) / sizeof(int));
+  std::vector<int> y(x.size());
+  while (state.KeepRunning()) {
+    eop::swap_ranges_n_streaming(x.data(), y.data(), int(x.size()));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 2);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_swap_ranges_n_streaming)->Arg(64<<10)->Arg(16<<20)->Arg(256<<20);
+
+static void BM_swap_ranges_n(benchmark::State& state) {
+  std::vector<int> x(state.range(0) / sizeof(int));
+  std::vector<int> y(x.size());
+  while (state.KeepRunning()) {
+    eop::swap_ranges_n(x.begin(), y.begin(), int(x.size()));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 2);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_swap_ranges_n)->Arg(64<<10)->Arg(16<<20)->Arg(256<<20);
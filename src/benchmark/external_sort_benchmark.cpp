@@ -0,0 +1,77 @@
+#include<cstdint>
+#include<cstdio>
+#include<random>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "external_sort.h"
+
+// 16-byte records with random keys, written to a file of the given size in
+// MB and sorted under a memory budget in MB
+struct record
+{
+  std::uint64_t key;
+  std::uint64_t payload;
+};
+
+struct record_less
+{
+  bool operator()(const record& x, const record& y) const { return x.key < y.key; }
+};
+
+static const char* const input_path = "external_sort_benchmark_input.bin";
+static const char* const output_path = "external_sort_benchmark_output.bin";
+
+static bool write_random_records(const char* path, std::size_t bytes) {
+  std::FILE* f = std::fopen(path, "wb");
+  if (f == 0) return false;
+  std::mt19937_64 g(1);
+  std::vector<record> block(1 << 16);
+  std::uint64_t i = 0;
+  bool good = true;
+  for (std::size_t n = bytes / sizeof(record); good && n != 0; ) {
+    std::size_t m = n < block.size() ? n : block.size();
+    for (std::size_t j = 0; j < m; ++j) block[j] = record{ g(), i++ };
+    good = std::fwrite(block.data(), sizeof(record), m, f) == m;
+    n = n - m;
+  }
+  return std::fclose(f) == 0 && good;
+}
+
+static void BM_external_sort(benchmark::State& state) {
+  std::size_t bytes = std::size_t(state.range(0)) << 20;
+  std::size_t budget = std::size_t(state.range(1)) << 20;
+  if (!write_random_records(input_path, bytes)) {
+    state.SkipWithError("cannot write the input file");
+    return;
+  }
+  while (state.KeepRunning()) {
+    if (!eop::external_sort<record>(input_path, output_path, budget, record_less()))
+      state.SkipWithError("external_sort failed");
+  }
+  state.SetBytesProcessed(state.iterations() * bytes);
+  std::remove(input_path);
+  std::remove(output_path);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_external_sort)->Args({ 256, 32 })->Args({ 256, 256 })->Args({ 4096, 512 })
+  ->Iterations(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_sort_n_with_buffer(benchmark::State& state) {
+  // The in-memory sort of one chunk
+  std::size_t n = (std::size_t(state.range(0)) << 20) / sizeof(record);
+  std::mt19937_64 g(1);
+  std::vector<record> x(n);
+  std::vector<record> y(n);
+  std::vector<record> b(n / 2 + 1);
+  for (record& r : x) r = record{ g(), 0 };
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    y = x;
+    state.ResumeTiming();
+    eop::sort_n_with_buffer(y.data(), int(n), b.data(), record_less());
+  }
+  state.SetBytesProcessed(state.iterations() * n * sizeof(record));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_sort_n_with_buffer)->Arg(32)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,77 @@
+#include<algorithm>
+#include<random>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "eop.h"
+#include "project_7_1.h"
+#include "tree.h"
+
+typedef eop::tree_coordinate<long> Coordinate;
+
+// Builds a balanced tree holding the even values in [2 f, 2 (f + n)) in
+// order, so that half of the keys looked up are absent; the predecessor
+// links are set for the traversal of the linear find
+static Coordinate build_ordered(long f, long n, Coordinate p = Coordinate{ 0 }) {
+  if (n == 0) return Coordinate{ 0 };
+  long h = n / 2;
+  Coordinate c = eop::tree_node_construct<long>{}(2 * (f + h));
+  eop::set_predecessor(c, p);
+  eop::set_left_successor(c, build_ordered(f, h, c));
+  eop::set_right_successor(c, build_ordered(f + h + 1, n - h - 1, c));
+  return c;
+}
+
+struct ordered_tree
+{
+  Coordinate root;
+  ordered_tree(long n) : root(build_ordered(0, n)) {}
+  ~ordered_tree() { eop::bifurcate_erase(root, eop::tree_node_destroy<long>{}); }
+};
+
+static const long tree_size = 1 << 20;
+
+static std::vector<long> random_keys(long n) {
+  std::mt19937_64 g(42);
+  std::uniform_int_distribution<long> d(0, 2 * tree_size - 1);
+  std::vector<long> keys(n);
+  for (long& k : keys) k = d(g);
+  return keys;
+}
+
+static void BM_find_linear(benchmark::State& state) {
+  ordered_tree t(tree_size);
+  std::vector<long> keys = random_keys(16);
+  while (state.KeepRunning()) {
+    for (long k : keys) benchmark::DoNotOptimize(eop::find(t.root, k));
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_find_linear)->Unit(benchmark::kMillisecond);
+
+static void BM_find_ordered(benchmark::State& state) {
+  ordered_tree t(tree_size);
+  std::vector<long> keys = random_keys(state.range(0));
+  std::sort(keys.begin(), keys.end());
+  while (state.KeepRunning()) {
+    for (long k : keys) benchmark::DoNotOptimize(eop::find_ordered(t.root, k));
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_find_ordered)->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 18);
+
+static void BM_find_ordered_n(benchmark::State& state) {
+  ordered_tree t(tree_size);
+  std::vector<long> keys = random_keys(state.range(0));
+  std::sort(keys.begin(), keys.end());
+  std::vector<Coordinate> found(keys.size());
+  while (state.KeepRunning()) {
+    eop::find_ordered_n(t.root, keys.data(), std::ptrdiff_t(keys.size()), found.data(), eop::less<long>());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_find_ordered_n)->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 18);
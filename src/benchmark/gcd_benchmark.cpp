@@ -0,0 +1,90 @@
+#include<cstdlib>
+#include<numeric>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "eop.h"
+
+static std::vector<int> gcd_input(int n, int seed) {
+  std::vector<int> v(n);
+  std::srand(seed);
+  for (int& x : v) x = std::rand();
+  return v;
+}
+
+static void BM_gcd_remainder(benchmark::State& state) {
+  std::vector<int> a = gcd_input(state.range(0), 1);
+  std::vector<int> b = gcd_input(state.range(0), 2);
+  while (state.KeepRunning()) {
+    int r = 0;
+    for (size_t i = 0; i < a.size(); ++i) r += eop::gcd_remainder(a[i], b[i]);
+    benchmark::DoNotOptimize(r);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_gcd_remainder)->Arg(1<<10)->Arg(1<<16);
+
+static void BM_gcd_binary(benchmark::State& state) {
+  std::vector<int> a = gcd_input(state.range(0), 1);
+  std::vector<int> b = gcd_input(state.range(0), 2);
+  while (state.KeepRunning()) {
+    int r = 0;
+    for (size_t i = 0; i < a.size(); ++i) r += eop::gcd_binary(a[i], b[i]);
+    benchmark::DoNotOptimize(r);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_gcd_binary)->Arg(1<<10)->Arg(1<<16);
+
+static void BM_gcd_n(benchmark::State& state) {
+  std::vector<int> a = gcd_input(state.range(0), 1);
+  std::vector<int> b = gcd_input(state.range(0), 2);
+  std::vector<int> g(state.range(0));
+  while (state.KeepRunning()) {
+    eop::gcd_n(a.begin(), b.begin(), int(a.size()), g.begin());
+    benchmark::DoNotOptimize(g.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_gcd_n)->Arg(1<<10)->Arg(1<<16);
+
+static void BM_extended_gcd(benchmark::State& state) {
+  std::vector<int> a = gcd_input(state.range(0), 1);
+  std::vector<int> b = gcd_input(state.range(0), 2);
+  while (state.KeepRunning()) {
+    int r = 0;
+    for (size_t i = 0; i < a.size(); ++i) r += std::get<1>(eop::extended_gcd(a[i], b[i]));
+    benchmark::DoNotOptimize(r);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_extended_gcd)->Arg(1<<10)->Arg(1<<16);
+
+// rotate_cycles computes gcd(m - f, l - m) once per call, which dominates
+// small rotations with many cycles
+static void BM_rotate_cycles_gcd_remainder(benchmark::State& state) {
+  std::vector<int> input(state.range(0));
+  std::iota(input.begin(), input.end(), 0);
+  int k = state.range(0) / 2 - 2;
+  while (state.KeepRunning()) {
+    auto f = input.begin();
+    eop::k_rotate_from_permutation_random_access<std::vector<int>::iterator> from(f, f + k, input.end());
+    int d = eop::gcd_remainder(k, int(input.size()) - k);
+    while (eop::count_down(d)) eop::cycle_from(f + d, from);
+    benchmark::DoNotOptimize(input.data());
+  }
+}
+BENCHMARK(BM_rotate_cycles_gcd_remainder)->Arg(64)->Arg(1<<10);
+
+static void BM_rotate_cycles_gcd_binary(benchmark::State& state) {
+  std::vector<int> input(state.range(0));
+  std::iota(input.begin(), input.end(), 0);
+  int k = state.range(0) / 2 - 2;
+  while (state.KeepRunning()) {
+    auto f = input.begin();
+    eop::k_rotate_from_permutation_random_access<std::vector<int>::iterator> from(f, f + k, input.end());
+    eop::rotate_cycles(f, f + k, input.end(), from);
+    benchmark::DoNotOptimize(input.data());
+  }
+}
+BENCHMARK(BM_rotate_cycles_gcd_binary)->Arg(64)->Arg(1<<10);
@@ -0,0 +1,70 @@
+#include<algorithm>
+#include<functional>
+#include<random>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "eop.h"
+
+// Two increasing halves of random ints, merged in place
+static const int inplace_merge_size = 1 << 20;
+
+static std::vector<int> make_halves() {
+  std::mt19937 g(13);
+  std::uniform_int_distribution<int> d(0, 1 << 20);
+  std::vector<int> x(inplace_merge_size);
+  for (int& a : x) a = d(g);
+  std::sort(x.begin(), x.begin() + inplace_merge_size / 2);
+  std::sort(x.begin() + inplace_merge_size / 2, x.end());
+  return x;
+}
+
+static void BM_merge_n_adaptive(benchmark::State& state) {
+  // A buffer of state.range(0) elements; 1024 is sqrt(inplace_merge_size)
+  // and inplace_merge_size / 2 holds the whole first half
+  std::vector<int> x = make_halves();
+  std::vector<int> y(x.size());
+  std::vector<int> b(state.range(0));
+  int n = inplace_merge_size / 2;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    y = x;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(eop::merge_n_adaptive(y.data(), n, y.data() + n, n, b.data(), int(b.size()), std::less<int>()));
+  }
+  state.SetItemsProcessed(state.iterations() * inplace_merge_size);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_merge_n_adaptive)->Arg(0)->Arg(1024)->Arg(inplace_merge_size / 16)->Arg(inplace_merge_size / 2)->Unit(benchmark::kMillisecond);
+
+static void BM_merge_symmetric(benchmark::State& state) {
+  std::vector<int> x = make_halves();
+  std::vector<int> y(x.size());
+  int n = inplace_merge_size / 2;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    y = x;
+    state.ResumeTiming();
+    eop::merge_symmetric(y.data(), y.data() + n, y.data() + 2 * n, std::less<int>());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * inplace_merge_size);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_merge_symmetric)->Unit(benchmark::kMillisecond);
+
+static void BM_std_inplace_merge(benchmark::State& state) {
+  std::vector<int> x = make_halves();
+  std::vector<int> y(x.size());
+  int n = inplace_merge_size / 2;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    y = x;
+    state.ResumeTiming();
+    std::inplace_merge(y.begin(), y.begin() + n, y.end());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * inplace_merge_size);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_std_inplace_merge)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,230 @@
+#include<functional>
+#include<list>
+#include<random>
+#include<string>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "list.h"
+
+static std::vector<int> random_ints(int n) {
+  std::mt19937 g(n);
+  std::vector<int> v(n);
+  for (auto& x : v) x = int(g());
+  return v;
+}
+
+static void BM_push_back_std_list(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    std::list<int> l;
+    for (int i = 0; i < state.range(0); ++i) l.push_back(i);
+    benchmark::DoNotOptimize(l.back());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_push_back_std_list)->Arg(1<<10)->Arg(1<<16)->Arg(1<<20);
+
+static void BM_push_back_slab_list(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    eop::list_slab<int> slab;
+    eop::slab_list<int> l(slab);
+    for (int i = 0; i < state.range(0); ++i) eop::push_back(l, i);
+    benchmark::DoNotOptimize(eop::source(eop::predecessor(eop::end(l))));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_push_back_slab_list)->Arg(1<<10)->Arg(1<<16)->Arg(1<<20);
+
+static void BM_sort_std_list(benchmark::State& state) {
+  auto input = random_ints(state.range(0));
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    std::list<int> l(input.begin(), input.end());
+    state.ResumeTiming();
+    l.sort();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_sort_std_list)->Arg(1<<10)->Arg(1<<16)->Arg(1<<20);
+
+static void BM_sort_slab_list(benchmark::State& state) {
+  auto input = random_ints(state.range(0));
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    eop::list_slab<int> slab;
+    eop::slab_list<int> l(slab);
+    for (int x : input) eop::push_back(l, x);
+    state.ResumeTiming();
+    eop::sort(l, std::less<int>());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_sort_slab_list)->Arg(1<<10)->Arg(1<<16)->Arg(1<<20);
+
+struct is_odd {
+  bool operator()(int x) const { return x % 2 != 0; }
+};
+
+static void BM_partition_std_list(benchmark::State& state) {
+  auto input = random_ints(state.range(0));
+  std::list<int> x(input.begin(), input.end());
+  std::list<int> y;
+  while (state.KeepRunning()) {
+    for (auto i = x.begin(); i != x.end();) {
+      auto j = std::next(i);
+      if (is_odd()(*i)) y.splice(y.end(), x, i);
+      i = j;
+    }
+    x.splice(x.end(), y);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_partition_std_list)->Arg(1<<10)->Arg(1<<16)->Arg(1<<20);
+
+static void BM_partition_slab_list(benchmark::State& state) {
+  auto input = random_ints(state.range(0));
+  eop::list_slab<int> slab;
+  eop::slab_list<int> x(slab);
+  eop::slab_list<int> y(slab);
+  for (int v : input) eop::push_back(x, v);
+  while (state.KeepRunning()) {
+    eop::partition(x, is_odd(), y);
+    eop::splice(eop::end(x), eop::begin(y), eop::end(y));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_partition_slab_list)->Arg(1<<10)->Arg(1<<16)->Arg(1<<20);
+
+// Moves a random element to the front, as an LRU cache does on a hit
+static void BM_move_to_front_std_list(benchmark::State& state) {
+  std::list<int> l;
+  std::vector<std::list<int>::iterator> nodes;
+  for (int i = 0; i < state.range(0); ++i) nodes.push_back(l.insert(l.end(), i));
+  std::mt19937 g(0);
+  std::uniform_int_distribution<int> d(0, int(state.range(0)) - 1);
+  while (state.KeepRunning()) {
+    l.splice(l.begin(), l, nodes[d(g)]);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_move_to_front_std_list)->Arg(1<<10)->Arg(1<<20);
+
+static void BM_move_to_front_slab_list(benchmark::State& state) {
+  eop::list_slab<int> slab;
+  eop::slab_list<int> l(slab);
+  std::vector<eop::list_iterator<int>> nodes;
+  for (int i = 0; i < state.range(0); ++i) nodes.push_back(eop::insert(l, eop::end(l), i));
+  std::mt19937 g(0);
+  std::uniform_int_distribution<int> d(0, int(state.range(0)) - 1);
+  while (state.KeepRunning()) {
+    auto i = nodes[d(g)];
+    eop::splice(eop::begin(l), i, eop::successor(i));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_move_to_front_slab_list)->Arg(1<<10)->Arg(1<<20);
+
+// Strings long enough to defeat the small string optimisation
+static std::vector<std::string> random_strings(int n) {
+  std::mt19937 g(n);
+  std::vector<std::string> v(n);
+  for (auto& s : v) s = std::string(48, 'a') + std::to_string(g());
+  return v;
+}
+
+template<typename I>
+static void erase_list(I i) {
+  eop::erase_all(i);
+}
+
+static void BM_slist_construct_copy(benchmark::State& state) {
+  typedef eop::slist_iterator<std::string> I;
+  auto input = random_strings(state.range(0));
+  eop::slist_node_construct<std::string> cons;
+  while (state.KeepRunning()) {
+    I h(0);
+    for (auto const& s : input) h = cons(s, h);
+    state.PauseTiming();
+    erase_list(h);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_slist_construct_copy)->Arg(1<<10)->Arg(1<<16);
+
+static void BM_slist_construct_move(benchmark::State& state) {
+  typedef eop::slist_iterator<std::string> I;
+  auto input = random_strings(state.range(0));
+  eop::slist_node_construct<std::string> cons;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    auto v = input;
+    state.ResumeTiming();
+    I h(0);
+    for (auto& s : v) h = cons(std::move(s), h);
+    state.PauseTiming();
+    erase_list(h);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_slist_construct_move)->Arg(1<<10)->Arg(1<<16);
+
+static void BM_slist_builder_emplace(benchmark::State& state) {
+  auto input = random_strings(state.range(0));
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    auto v = input;
+    state.ResumeTiming();
+    eop::slist_builder<std::string> b;
+    for (auto& s : v) b.emplace_back(std::move(s));
+    state.PauseTiming();
+    {
+      eop::slist<std::string> l = b.release();
+    }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_slist_builder_emplace)->Arg(1<<10)->Arg(1<<16);
+
+static void BM_sort_linked_strings(benchmark::State& state) {
+  typedef eop::slist_iterator<std::string> I;
+  auto input = random_strings(state.range(0));
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    eop::slist_builder<std::string> b;
+    for (auto const& s : input) b.push_back(s);
+    eop::slist<std::string> l = b.release();
+    state.ResumeTiming();
+    l.root = eop::sort_linked_n(l.root, int(input.size()), std::less<std::string>(),
+                                eop::forward_linker<I>()).first;
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_sort_linked_strings)->Arg(1<<10)->Arg(1<<16);
+
+static void BM_sort_std_list_strings(benchmark::State& state) {
+  auto input = random_strings(state.range(0));
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    std::list<std::string> l(input.begin(), input.end());
+    state.ResumeTiming();
+    l.sort();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_sort_std_list_strings)->Arg(1<<10)->Arg(1<<16);
@@ -0,0 +1,171 @@
+#include<random>
+#include<utility>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "eop.h"
+
+// k increasing runs of random values, laid out one after another
+static const long merge_size = 1 << 22;
+
+static std::vector<long> make_runs(long k) {
+  std::mt19937_64 g(7);
+  std::uniform_int_distribution<long> d(0, 1 << 10);
+  std::vector<long> x(merge_size);
+  long m = merge_size / k;
+  for (long i = 0; i < merge_size; ++i) x[i] = i % m == 0 ? d(g) : x[i - 1] + d(g);
+  return x;
+}
+
+static void BM_merge_copy_k(benchmark::State& state) {
+  long k = state.range(0);
+  long m = merge_size / k;
+  std::vector<long> x = make_runs(k);
+  std::vector<long> y(merge_size);
+  typedef std::pair<const long*, const long*> Range;
+  std::vector<Range> ranges;
+  for (long i = 0; i < k; ++i) ranges.push_back(Range(x.data() + i * m, x.data() + (i + 1) * m));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::merge_copy_k(ranges.begin(), ranges.end(), y.data(), eop::less<long>()));
+  }
+  state.SetItemsProcessed(state.iterations() * merge_size);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_merge_copy_k)->Arg(2)->Arg(64)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void BM_merge_copy_n_pairwise(benchmark::State& state) {
+  // Merges adjacent pairs of runs between two buffers until one run is left
+  long k = state.range(0);
+  std::vector<long> x = make_runs(k);
+  std::vector<long> y(merge_size);
+  std::vector<long> z(merge_size);
+  while (state.KeepRunning()) {
+    const long* f = x.data();
+    long* o = y.data();
+    for (long m = merge_size / k; m < merge_size; m = 2 * m) {
+      for (long i = 0; i < merge_size; i = i + 2 * m)
+        eop::merge_copy_n(f + i, m, f + i + m, m, o + i, eop::less<long>());
+      f = o;
+      o = o == y.data() ? z.data() : y.data();
+    }
+    benchmark::DoNotOptimize(f);
+  }
+  state.SetItemsProcessed(state.iterations() * merge_size);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_merge_copy_n_pairwise)->Arg(2)->Arg(64)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+// 64-byte records ordered by their first word, for which each pass of the
+// pairwise merge copies the whole record
+struct record
+{
+  long key;
+  long payload[7];
+};
+
+struct record_less
+{
+  bool operator()(const record& x, const record& y) const { return x.key < y.key; }
+};
+
+static std::vector<record> make_record_runs(long k) {
+  std::vector<long> x = make_runs(k);
+  std::vector<record> y(merge_size / 8);
+  for (std::size_t i = 0; i < y.size(); ++i) y[i].key = x[(i / (y.size() / k)) * (merge_size / k) + i % (y.size() / k)];
+  return y;
+}
+
+static void BM_merge_copy_k_record(benchmark::State& state) {
+  long k = state.range(0);
+  std::vector<record> x = make_record_runs(k);
+  long n = long(x.size());
+  long m = n / k;
+  std::vector<record> y(n);
+  typedef std::pair<const record*, const record*> Range;
+  std::vector<Range> ranges;
+  for (long i = 0; i < k; ++i) ranges.push_back(Range(x.data() + i * m, x.data() + (i + 1) * m));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::merge_copy_k(ranges.begin(), ranges.end(), y.data(), record_less()));
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_merge_copy_k_record)->Arg(64)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void BM_merge_copy_n_pairwise_record(benchmark::State& state) {
+  long k = state.range(0);
+  std::vector<record> x = make_record_runs(k);
+  long n = long(x.size());
+  std::vector<record> y(n);
+  std::vector<record> z(n);
+  while (state.KeepRunning()) {
+    const record* f = x.data();
+    record* o = y.data();
+    for (long m = n / k; m < n; m = 2 * m) {
+      for (long i = 0; i < n; i = i + 2 * m)
+        eop::merge_copy_n(f + i, m, f + i + m, m, o + i, record_less());
+      f = o;
+      o = o == y.data() ? z.data() : y.data();
+    }
+    benchmark::DoNotOptimize(f);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_merge_copy_n_pairwise_record)->Arg(64)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+// Two increasing ranges of ints of merge_size / 2 elements each; with
+// state.range(0) == 1 they interleave at random, otherwise they alternate
+// in clusters of about state.range(0) elements
+static std::pair<std::vector<int>, std::vector<int>> make_interleaving(int c) {
+  std::mt19937 g(11);
+  std::uniform_int_distribution<int> d(0, 2 * c - 1);
+  std::vector<int> x, y;
+  int v = 0;
+  bool to_x = true;
+  while (x.size() < merge_size / 2 || y.size() < merge_size / 2) {
+    if (c == 1) to_x = d(g) == 0;
+    else if (d(g) == 0) to_x = !to_x;
+    std::vector<int>& z = to_x && x.size() < merge_size / 2 ? x
+                        : y.size() < merge_size / 2 ? y : x;
+    z.push_back(v++);
+  }
+  return std::make_pair(x, y);
+}
+
+static void BM_merge_copy_n_iterator(benchmark::State& state) {
+  // The generic merge, which merge_copy_n takes for pointers as well
+  std::pair<std::vector<int>, std::vector<int>> x = make_interleaving(state.range(0));
+  std::vector<int> y(merge_size);
+  int n = int(merge_size / 2);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::merge_copy_n(x.first.cbegin(), n, x.second.cbegin(), n, y.begin(), eop::less<int>()));
+  }
+  state.SetItemsProcessed(state.iterations() * merge_size);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_merge_copy_n_iterator)->Arg(1)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond);
+
+static void BM_merge_copy_n_branchless(benchmark::State& state) {
+  std::pair<std::vector<int>, std::vector<int>> x = make_interleaving(state.range(0));
+  std::vector<int> y(merge_size);
+  int n = int(merge_size / 2);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::merge_copy_n_branchless(x.first.data(), n, x.second.data(), n, y.data(), std::less<int>()));
+  }
+  state.SetItemsProcessed(state.iterations() * merge_size);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_merge_copy_n_branchless)->Arg(1)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond);
+
+static void BM_merge_copy_n_bitonic(benchmark::State& state) {
+  std::pair<std::vector<int>, std::vector<int>> x = make_interleaving(state.range(0));
+  std::vector<int> y(merge_size);
+  int n = int(merge_size / 2);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::merge_copy_n_bitonic(x.first.data(), n, x.second.data(), n, y.data()));
+  }
+  state.SetItemsProcessed(state.iterations() * merge_size);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_merge_copy_n_bitonic)->Arg(1)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,194 @@
+#include<algorithm>
+#include<functional>
+#include<random>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "eop.h"
+
+// The predicate holds for about state.range(1) percent of the elements, in
+// random order, so at 50 the branch on it cannot be predicted
+struct less_than_percent
+{
+  typedef int first_argument_type;
+  typedef bool result_type;
+  int k;
+  bool operator()(int a) const { return a < k; }
+};
+
+static std::vector<int> partition_input(int n)
+{
+  std::mt19937 g(n);
+  std::uniform_int_distribution<int> d(0, 99);
+  std::vector<int> v(n);
+  for (int& a : v) a = d(g);
+  return v;
+}
+
+static void BM_partition_bidirectional(benchmark::State& state) {
+  std::vector<int> input = partition_input(state.range(0));
+  std::vector<int> v(input.size());
+  less_than_percent p { int(state.range(1)) };
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    v = input;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(eop::partition_bidirectional(v.data(), v.data() + v.size(), p));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_partition_bidirectional)->ArgsProduct({ { 1 << 20 }, { 1, 10, 50, 90, 99 } });
+
+static void BM_partition_forward(benchmark::State& state) {
+  std::vector<int> input = partition_input(state.range(0));
+  std::vector<int> v(input.size());
+  less_than_percent p { int(state.range(1)) };
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    v = input;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(eop::partition_forward(v.data(), v.data() + v.size(), p));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_partition_forward)->ArgsProduct({ { 1 << 20 }, { 1, 10, 50, 90, 99 } });
+
+static void BM_partition_block(benchmark::State& state) {
+  std::vector<int> input = partition_input(state.range(0));
+  std::vector<int> v(input.size());
+  less_than_percent p { int(state.range(1)) };
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    v = input;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(eop::partition_block(v.data(), v.data() + v.size(), p));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_partition_block)->ArgsProduct({ { 1 << 20 }, { 1, 10, 50, 90, 99 } });
+
+static void BM_std_partition(benchmark::State& state) {
+  std::vector<int> input = partition_input(state.range(0));
+  std::vector<int> v(input.size());
+  less_than_percent p { int(state.range(1)) };
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    v = input;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(std::partition(v.begin(), v.end(), [p](int a) { return !p(a); }));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_std_partition)->ArgsProduct({ { 1 << 20 }, { 1, 10, 50, 90, 99 } });
+
+// Low-cardinality input: state.range(1) distinct values in random order
+static std::vector<int> few_distinct_input(int n, int c)
+{
+  std::mt19937 g(n + c);
+  std::uniform_int_distribution<int> d(0, c - 1);
+  std::vector<int> v(n);
+  for (int& a : v) a = d(g);
+  return v;
+}
+
+static void BM_partition_three_way(benchmark::State& state) {
+  std::vector<int> input = few_distinct_input(state.range(0), state.range(1));
+  std::vector<int> v(input.size());
+  int a = int(state.range(1)) / 2;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    v = input;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(eop::partition_three_way(v.data(), v.data() + v.size(), a, std::less<int>()));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_partition_three_way)->ArgsProduct({ { 1 << 20 }, { 3, 16 } });
+
+static void BM_partition_three_way_bidirectional(benchmark::State& state) {
+  std::vector<int> input = few_distinct_input(state.range(0), state.range(1));
+  std::vector<int> v(input.size());
+  int a = int(state.range(1)) / 2;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    v = input;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(eop::partition_three_way_bidirectional(v.data(), v.data() + v.size(), a, std::less<int>()));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_partition_three_way_bidirectional)->ArgsProduct({ { 1 << 20 }, { 3, 16 } });
+
+static void BM_partition_three_way_stable_with_buffer(benchmark::State& state) {
+  std::vector<int> input = few_distinct_input(state.range(0), state.range(1));
+  std::vector<int> v(input.size());
+  std::vector<int> b(input.size());
+  int a = int(state.range(1)) / 2;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    v = input;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(eop::partition_three_way_stable_with_buffer(v.data(), v.data() + v.size(), b.data(), a, std::less<int>()));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_partition_three_way_stable_with_buffer)->ArgsProduct({ { 1 << 20 }, { 3, 16 } });
+
+struct value_bucket
+{
+  int operator()(int a) const { return a; }
+};
+
+static void BM_partition_buckets_n(benchmark::State& state) {
+  std::vector<int> input = few_distinct_input(state.range(0), state.range(1));
+  std::vector<int> v(input.size());
+  std::vector<int*> bounds(state.range(1) + 1);
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    v = input;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(eop::partition_buckets_n(v.data(), int(v.size()), value_bucket(), int(state.range(1)), bounds.data()));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_partition_buckets_n)->ArgsProduct({ { 1 << 20 }, { 4, 16, 256 } });
+
+static void BM_partition_buckets_stable_n_with_buffer(benchmark::State& state) {
+  std::vector<int> input = few_distinct_input(state.range(0), state.range(1));
+  std::vector<int> v(input.size());
+  std::vector<int> b(input.size());
+  std::vector<int*> bounds(state.range(1) + 1);
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    v = input;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(eop::partition_buckets_stable_n_with_buffer(v.data(), int(v.size()), b.data(), value_bucket(), int(state.range(1)), bounds.data()));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_partition_buckets_stable_n_with_buffer)->ArgsProduct({ { 1 << 20 }, { 4, 16, 256 } });
+
+static void BM_partition_buckets_sort_n(benchmark::State& state) {
+  // Grouping by sorting, for comparison
+  std::vector<int> input = few_distinct_input(state.range(0), state.range(1));
+  std::vector<int> v(input.size());
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    v = input;
+    state.ResumeTiming();
+    eop::sort_n(v.data(), int(v.size()), std::less<int>());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_partition_buckets_sort_n)->ArgsProduct({ { 1 << 20 }, { 4, 16, 256 } });
@@ -0,0 +1,125 @@
+#include<algorithm>
+#include<cstdint>
+#include<functional>
+#include<random>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "eop.h"
+#include "list.h"
+
+static const int radix_size = 1 << 20;
+
+template<typename T>
+static std::vector<T> random_keys(int n) {
+  std::mt19937_64 g(3);
+  std::vector<T> x(n);
+  for (T& a : x) a = T(std::int64_t(g()) >> 1);
+  return x;
+}
+
+template<>
+std::vector<float> random_keys<float>(int n) {
+  std::mt19937 g(3);
+  std::normal_distribution<float> d(0.0f, 1000.0f);
+  std::vector<float> x(n);
+  for (float& a : x) a = d(g);
+  return x;
+}
+
+template<typename T>
+static void BM_radix_sort_lsd_n(benchmark::State& state) {
+  std::vector<T> x = random_keys<T>(radix_size);
+  std::vector<T> y(x.size());
+  std::vector<T> b(x.size());
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    y = x;
+    state.ResumeTiming();
+    eop::radix_sort_lsd_n(y.data(), radix_size, b.data(), eop::radix_identity());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * radix_size);
+}
+// Register the function as a benchmark
+BENCHMARK_TEMPLATE(BM_radix_sort_lsd_n, int)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_radix_sort_lsd_n, std::uint64_t)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_radix_sort_lsd_n, float)->Unit(benchmark::kMillisecond);
+
+template<typename T>
+static void BM_radix_sort_msd_n(benchmark::State& state) {
+  std::vector<T> x = random_keys<T>(radix_size);
+  std::vector<T> y(x.size());
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    y = x;
+    state.ResumeTiming();
+    eop::radix_sort_msd_n(y.data(), radix_size, eop::radix_identity());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * radix_size);
+}
+// Register the function as a benchmark
+BENCHMARK_TEMPLATE(BM_radix_sort_msd_n, int)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_radix_sort_msd_n, std::uint64_t)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_radix_sort_msd_n, float)->Unit(benchmark::kMillisecond);
+
+template<typename T>
+static void BM_radix_std_sort(benchmark::State& state) {
+  std::vector<T> x = random_keys<T>(radix_size);
+  std::vector<T> y(x.size());
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    y = x;
+    state.ResumeTiming();
+    std::sort(y.begin(), y.end());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * radix_size);
+}
+// Register the function as a benchmark
+BENCHMARK_TEMPLATE(BM_radix_std_sort, int)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_radix_std_sort, std::uint64_t)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_radix_std_sort, float)->Unit(benchmark::kMillisecond);
+
+static void BM_sort_linked_radix_n(benchmark::State& state) {
+  typedef eop::slist_iterator<int> I;
+  std::vector<int> x = random_keys<int>(int(state.range(0)));
+  I root;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    eop::erase_all(root);
+    eop::slist_builder<int> b;
+    for (int a : x) b.emplace_back(a);
+    eop::slist<int> l = b.release();
+    root = l.root;
+    l.root = I();
+    state.ResumeTiming();
+    root = eop::sort_linked_radix_n(root, int(x.size()), eop::radix_identity(), eop::forward_linker<I>()).first;
+  }
+  eop::erase_all(root);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_sort_linked_radix_n)->Arg(1<<16)->Arg(1<<20)->Unit(benchmark::kMillisecond);
+
+static void BM_sort_linked_merge_n(benchmark::State& state) {
+  typedef eop::slist_iterator<int> I;
+  std::vector<int> x = random_keys<int>(int(state.range(0)));
+  I root;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    eop::erase_all(root);
+    eop::slist_builder<int> b;
+    for (int a : x) b.emplace_back(a);
+    eop::slist<int> l = b.release();
+    root = l.root;
+    l.root = I();
+    state.ResumeTiming();
+    root = eop::sort_linked_n(root, int(x.size()), std::less<int>(), eop::forward_linker<I>()).first;
+  }
+  eop::erase_all(root);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_sort_linked_merge_n)->Arg(1<<16)->Arg(1<<20)->Unit(benchmark::kMillisecond);
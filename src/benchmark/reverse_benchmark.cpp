@@ -0,0 +1,67 @@
+#include<algorithm>
+#include<cstdint>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "eop.h"
+
+template<int S>
+struct bytes
+{
+  char c[S];
+};
+
+// Pointers to trivially copyable elements take the blocked reverse
+
+template<typename T>
+static void BM_reverse_n_random_access_contiguous(benchmark::State& state) {
+  std::vector<T> input(state.range(0));
+  while (state.KeepRunning()) {
+    eop::reverse_n_random_access(input.data(), int(input.size()));
+    benchmark::DoNotOptimize(input.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_reverse_n_random_access_contiguous, std::uint8_t)->Arg(1<<10)->Arg(1<<20)->Arg(1<<24);
+BENCHMARK_TEMPLATE(BM_reverse_n_random_access_contiguous, std::uint16_t)->Arg(1<<10)->Arg(1<<20);
+BENCHMARK_TEMPLATE(BM_reverse_n_random_access_contiguous, std::uint32_t)->Arg(1<<10)->Arg(1<<20)->Arg(1<<22);
+BENCHMARK_TEMPLATE(BM_reverse_n_random_access_contiguous, std::uint64_t)->Arg(1<<10)->Arg(1<<20);
+BENCHMARK_TEMPLATE(BM_reverse_n_random_access_contiguous, bytes<16>)->Arg(1<<10)->Arg(1<<18);
+BENCHMARK_TEMPLATE(BM_reverse_n_random_access_contiguous, bytes<64>)->Arg(1<<10)->Arg(1<<16);
+BENCHMARK_TEMPLATE(BM_reverse_n_random_access_contiguous, bytes<512>)->Arg(1<<10)->Arg(1<<13);
+
+// Iterators of std::vector take the element by element reverse
+
+template<typename T>
+static void BM_reverse_n_random_access(benchmark::State& state) {
+  std::vector<T> input(state.range(0));
+  while (state.KeepRunning()) {
+    eop::reverse_n_random_access(input.begin(), int(input.size()));
+    benchmark::DoNotOptimize(input.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_reverse_n_random_access, std::uint8_t)->Arg(1<<10)->Arg(1<<20)->Arg(1<<24);
+BENCHMARK_TEMPLATE(BM_reverse_n_random_access, std::uint16_t)->Arg(1<<10)->Arg(1<<20);
+BENCHMARK_TEMPLATE(BM_reverse_n_random_access, std::uint32_t)->Arg(1<<10)->Arg(1<<20)->Arg(1<<22);
+BENCHMARK_TEMPLATE(BM_reverse_n_random_access, std::uint64_t)->Arg(1<<10)->Arg(1<<20);
+BENCHMARK_TEMPLATE(BM_reverse_n_random_access, bytes<16>)->Arg(1<<10)->Arg(1<<18);
+BENCHMARK_TEMPLATE(BM_reverse_n_random_access, bytes<64>)->Arg(1<<10)->Arg(1<<16);
+BENCHMARK_TEMPLATE(BM_reverse_n_random_access, bytes<512>)->Arg(1<<10)->Arg(1<<13);
+
+template<typename T>
+static void BM_reverse_std(benchmark::State& state) {
+  std::vector<T> input(state.range(0));
+  while (state.KeepRunning()) {
+    std::reverse(input.begin(), input.end());
+    benchmark::DoNotOptimize(input.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_reverse_std, std::uint8_t)->Arg(1<<10)->Arg(1<<20)->Arg(1<<24);
+BENCHMARK_TEMPLATE(BM_reverse_std, std::uint16_t)->Arg(1<<10)->Arg(1<<20);
+BENCHMARK_TEMPLATE(BM_reverse_std, std::uint32_t)->Arg(1<<10)->Arg(1<<20)->Arg(1<<22);
+BENCHMARK_TEMPLATE(BM_reverse_std, std::uint64_t)->Arg(1<<10)->Arg(1<<20);
+BENCHMARK_TEMPLATE(BM_reverse_std, bytes<16>)->Arg(1<<10)->Arg(1<<18);
+BENCHMARK_TEMPLATE(BM_reverse_std, bytes<64>)->Arg(1<<10)->Arg(1<<16);
+BENCHMARK_TEMPLATE(BM_reverse_std, bytes<512>)->Arg(1<<10)->Arg(1<<13);
@@ -106,3 +106,34 @@ static void BM_rotate_forward_annotated(benchmark::State& state) {
 }
 // Register the function as a benchmark
 BENCHMARK(BM_rotate_forward_annotated)->Arg(8)->Arg(64)->Arg(1<<10)->Arg(8<<10);
+
+// Rotations of 1M+ elements by k: k = n/2 and k = n/64 give many short
+// cycles, k = n/2 - 1 a single cycle through the whole range
+
+static void BM_rotate_random_access_nontrivial_large(benchmark::State& state) {
+  std::vector<int> input(state.range(0));
+  std::iota(input.begin(), input.end(), 0);
+  auto m = input.end() - state.range(1);
+  while (state.KeepRunning()) {
+    eop::rotate_random_access_nontrivial(input.begin(), m, input.end());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_rotate_random_access_nontrivial_large)
+  ->ArgPair(1<<20, 1<<19)->ArgPair(1<<20, (1<<19) - 1)->ArgPair(1<<20, 1<<14)
+  ->ArgPair(1<<23, 1<<22)->ArgPair(1<<23, (1<<22) - 1)->ArgPair(1<<23, 1<<17);
+
+static void BM_rotate_with_plan(benchmark::State& state) {
+  std::vector<int> input(state.range(0));
+  std::iota(input.begin(), input.end(), 0);
+  eop::rotate_plan<int> plan(state.range(0), state.range(1));
+  while (state.KeepRunning()) {
+    eop::rotate_with_plan(input.data(), plan);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_rotate_with_plan)
+  ->ArgPair(1<<20, 1<<19)->ArgPair(1<<20, (1<<19) - 1)->ArgPair(1<<20, 1<<14)
+  ->ArgPair(1<<23, 1<<22)->ArgPair(1<<23, (1<<22) - 1)->ArgPair(1<<23, 1<<17);
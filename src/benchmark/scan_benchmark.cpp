@@ -0,0 +1,69 @@
+#include<numeric>
+#include<random>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "eop.h"
+
+static const int scan_size = 1 << 24;
+
+static std::vector<int> scan_input(int n = scan_size) {
+  std::mt19937 g(1);
+  std::uniform_int_distribution<int> d(-1000, 1000);
+  std::vector<int> x(n);
+  for (int& a : x) a = d(g);
+  return x;
+}
+
+// The serial scans take state.range(0) elements, in cache or not
+
+static void BM_scan_inclusive_n_iterator(benchmark::State& state) {
+  // Through iterators the contiguous overloads don't match
+  int n = int(state.range(0));
+  std::vector<int> x = scan_input(n);
+  std::vector<int> y(x.size());
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::scan_inclusive_n(x.cbegin(), n, y.begin(), eop::plus<int>()));
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_scan_inclusive_n_iterator)->Arg(1 << 12)->Arg(scan_size);
+
+template<typename Op>
+static void BM_scan_inclusive_n(benchmark::State& state) {
+  int n = int(state.range(0));
+  std::vector<int> x = scan_input(n);
+  std::vector<int> y(x.size());
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::scan_inclusive_n(x.data(), n, y.data(), Op()));
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+// Register the function as a benchmark
+BENCHMARK_TEMPLATE(BM_scan_inclusive_n, eop::plus<int>)->Arg(1 << 12)->Arg(scan_size);
+BENCHMARK_TEMPLATE(BM_scan_inclusive_n, eop::maximum<int>)->Arg(1 << 12)->Arg(scan_size);
+
+static void BM_std_partial_sum(benchmark::State& state) {
+  int n = int(state.range(0));
+  std::vector<int> x = scan_input(n);
+  std::vector<int> y(x.size());
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(std::partial_sum(x.begin(), x.end(), y.begin()));
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_std_partial_sum)->Arg(1 << 12)->Arg(scan_size);
+
+static void BM_scan_inclusive_n_parallel(benchmark::State& state) {
+  // state.range(0) threads
+  std::vector<int> x = scan_input();
+  std::vector<int> y(x.size());
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::scan_inclusive_n_parallel(x.data(), scan_size, y.data(), eop::plus<int>(), int(state.range(0))));
+  }
+  state.SetItemsProcessed(state.iterations() * scan_size);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_scan_inclusive_n_parallel)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
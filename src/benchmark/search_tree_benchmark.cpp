@@ -0,0 +1,119 @@
+#include<random>
+#include<set>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "search_tree.h"
+
+static std::vector<int> random_keys(int n) {
+  std::mt19937 g(n);
+  std::vector<int> v(n);
+  for (auto& x : v) x = int(g() >> 1);
+  return v;
+}
+
+static void BM_insert_std_set(benchmark::State& state) {
+  auto keys = random_keys(state.range(0));
+  while (state.KeepRunning()) {
+    std::set<int> s;
+    for (int k : keys) s.insert(k);
+    benchmark::DoNotOptimize(s.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_insert_std_set)->Arg(1<<10)->Arg(1<<16)->Arg(1<<20);
+
+static void BM_insert_search_tree(benchmark::State& state) {
+  auto keys = random_keys(state.range(0));
+  while (state.KeepRunning()) {
+    eop::search_tree<int> s;
+    for (int k : keys) eop::insert(s, k);
+    benchmark::DoNotOptimize(eop::size(s));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_insert_search_tree)->Arg(1<<10)->Arg(1<<16)->Arg(1<<20);
+
+static void BM_lower_bound_std_set(benchmark::State& state) {
+  auto keys = random_keys(state.range(0));
+  std::set<int> s(keys.begin(), keys.end());
+  std::mt19937 g(0);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(s.lower_bound(int(g() >> 1)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_lower_bound_std_set)->Arg(1<<10)->Arg(1<<16)->Arg(1<<20);
+
+static void BM_lower_bound_search_tree(benchmark::State& state) {
+  auto keys = random_keys(state.range(0));
+  eop::search_tree<int> s;
+  for (int k : keys) eop::insert(s, k);
+  std::mt19937 g(0);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::lower_bound(s, int(g() >> 1)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_lower_bound_search_tree)->Arg(1<<10)->Arg(1<<16)->Arg(1<<20);
+
+// Erases and reinserts a random present key, keeping the size
+static void BM_erase_insert_std_set(benchmark::State& state) {
+  auto keys = random_keys(state.range(0));
+  std::set<int> s(keys.begin(), keys.end());
+  std::mt19937 g(0);
+  while (state.KeepRunning()) {
+    int k = keys[g() % keys.size()];
+    s.erase(k);
+    s.insert(k);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_erase_insert_std_set)->Arg(1<<10)->Arg(1<<20);
+
+static void BM_erase_insert_search_tree(benchmark::State& state) {
+  auto keys = random_keys(state.range(0));
+  eop::search_tree<int> s;
+  for (int k : keys) eop::insert(s, k);
+  std::mt19937 g(0);
+  while (state.KeepRunning()) {
+    int k = keys[g() % keys.size()];
+    eop::erase(s, k);
+    eop::insert(s, k);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_erase_insert_search_tree)->Arg(1<<10)->Arg(1<<20);
+
+static void BM_iterate_std_set(benchmark::State& state) {
+  auto keys = random_keys(state.range(0));
+  std::set<int> s(keys.begin(), keys.end());
+  while (state.KeepRunning()) {
+    long sum = 0;
+    for (int k : s) sum += k;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_iterate_std_set)->Arg(1<<16);
+
+static void BM_iterate_search_tree(benchmark::State& state) {
+  auto keys = random_keys(state.range(0));
+  eop::search_tree<int> s;
+  for (int k : keys) eop::insert(s, k);
+  while (state.KeepRunning()) {
+    long sum = 0;
+    for (auto i = begin(s); i != end(s); ++i) sum += *i;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_iterate_search_tree)->Arg(1<<16);
@@ -0,0 +1,176 @@
+#include<random>
+#include<utility>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "eop.h"
+#include "segment_tree.h"
+
+typedef eop::plus<long long> add_op;
+typedef eop::negate<long long> negate_op;
+
+static std::vector<long long> random_values(int n) {
+  std::mt19937 g(21);
+  std::vector<long long> x(n);
+  for (long long& a : x) a = (long long)(g() % 1000);
+  return x;
+}
+
+// The queries and updates are drawn ahead of the timing: each is a range
+// [i, j) of random bounds, or a position with a value
+
+static const int query_count = 1 << 12;
+
+static std::vector<std::pair<std::size_t, std::size_t>> random_ranges(int n) {
+  std::mt19937 g(23);
+  std::vector<std::pair<std::size_t, std::size_t>> x(query_count);
+  for (auto& r : x) {
+    std::size_t i = g() % (n + 1);
+    std::size_t j = g() % (n + 1);
+    r = i < j ? std::make_pair(i, j) : std::make_pair(j, i);
+  }
+  return x;
+}
+
+static void BM_segment_tree_build(benchmark::State& state) {
+  std::vector<long long> x = random_values(int(state.range(0)));
+  eop::segment_tree<add_op> t(add_op(), 0);
+  while (state.KeepRunning()) {
+    eop::build_n(t, x.data(), int(x.size()));
+    benchmark::DoNotOptimize(t.nodes.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_segment_tree_build)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_fenwick_tree_build(benchmark::State& state) {
+  std::vector<long long> x = random_values(int(state.range(0)));
+  eop::fenwick_tree<add_op, negate_op> t(add_op(), negate_op(), 0);
+  while (state.KeepRunning()) {
+    eop::build_n(t, x.data(), int(x.size()));
+    benchmark::DoNotOptimize(t.nodes.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_fenwick_tree_build)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_segment_tree_query(benchmark::State& state) {
+  int n = int(state.range(0));
+  std::vector<long long> x = random_values(n);
+  auto q = random_ranges(n);
+  eop::segment_tree<add_op> t(add_op(), 0);
+  eop::build_n(t, x.data(), n);
+  int k = 0;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::reduce(t, q[k].first, q[k].second));
+    k = (k + 1) & (query_count - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_segment_tree_query)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_fenwick_tree_query(benchmark::State& state) {
+  int n = int(state.range(0));
+  std::vector<long long> x = random_values(n);
+  auto q = random_ranges(n);
+  eop::fenwick_tree<add_op, negate_op> t(add_op(), negate_op(), 0);
+  eop::build_n(t, x.data(), n);
+  int k = 0;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::reduce(t, q[k].first, q[k].second));
+    k = (k + 1) & (query_count - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_fenwick_tree_query)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_reduce_recalculate_query(benchmark::State& state) {
+  // The reduction of each range from scratch, for comparison
+  int n = int(state.range(0));
+  std::vector<long long> x = random_values(n);
+  auto q = random_ranges(n);
+  int k = 0;
+  while (state.KeepRunning()) {
+    int m = int(q[k].second - q[k].first);
+    benchmark::DoNotOptimize(eop::reduce_nonempty_n(x.cbegin() + q[k].first, m, add_op(),
+                                                    eop::source_function<std::vector<long long>::const_iterator>(), 0LL));
+    k = (k + 1) & (query_count - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_reduce_recalculate_query)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_segment_tree_update(benchmark::State& state) {
+  int n = int(state.range(0));
+  std::vector<long long> x = random_values(n);
+  auto q = random_ranges(n);
+  eop::segment_tree<add_op> t(add_op(), 0);
+  eop::build_n(t, x.data(), n);
+  int k = 0;
+  while (state.KeepRunning()) {
+    eop::update(t, q[k].first % n, (long long)q[k].second);
+    k = (k + 1) & (query_count - 1);
+  }
+  benchmark::DoNotOptimize(t.nodes.data());
+  state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_segment_tree_update)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_fenwick_tree_add(benchmark::State& state) {
+  int n = int(state.range(0));
+  std::vector<long long> x = random_values(n);
+  auto q = random_ranges(n);
+  eop::fenwick_tree<add_op, negate_op> t(add_op(), negate_op(), 0);
+  eop::build_n(t, x.data(), n);
+  int k = 0;
+  while (state.KeepRunning()) {
+    eop::add(t, q[k].first % n, (long long)q[k].second);
+    k = (k + 1) & (query_count - 1);
+  }
+  benchmark::DoNotOptimize(t.nodes.data());
+  state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_fenwick_tree_add)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_segment_tree_mixed(benchmark::State& state) {
+  // Queries interleaved with updates, one update to every three queries
+  int n = int(state.range(0));
+  std::vector<long long> x = random_values(n);
+  auto q = random_ranges(n);
+  eop::segment_tree<add_op> t(add_op(), 0);
+  eop::build_n(t, x.data(), n);
+  int k = 0;
+  while (state.KeepRunning()) {
+    if ((k & 3) == 0) eop::update(t, q[k].first % n, (long long)q[k].second);
+    else benchmark::DoNotOptimize(eop::reduce(t, q[k].first, q[k].second));
+    k = (k + 1) & (query_count - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_segment_tree_mixed)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_fenwick_tree_mixed(benchmark::State& state) {
+  // Queries interleaved with updates, one update to every three queries
+  int n = int(state.range(0));
+  std::vector<long long> x = random_values(n);
+  auto q = random_ranges(n);
+  eop::fenwick_tree<add_op, negate_op> t(add_op(), negate_op(), 0);
+  eop::build_n(t, x.data(), n);
+  int k = 0;
+  while (state.KeepRunning()) {
+    if ((k & 3) == 0) eop::update(t, q[k].first % n, (long long)q[k].second);
+    else benchmark::DoNotOptimize(eop::reduce(t, q[k].first, q[k].second));
+    k = (k + 1) & (query_count - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_fenwick_tree_mixed)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
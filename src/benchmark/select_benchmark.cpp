@@ -0,0 +1,68 @@
+#include<algorithm>
+#include<cstdlib>
+#include<functional>
+#include<numeric>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "eop.h"
+
+enum input_shape { input_sorted, input_reversed, input_random, input_median_3_killer };
+
+static std::vector<int> select_input(int n, int shape) {
+  std::vector<int> v(n);
+  std::iota(v.begin(), v.end(), 0);
+  switch (shape) {
+    case input_reversed: std::reverse(v.begin(), v.end()); break;
+    case input_random:  std::srand(n); for (int& x : v) x = std::rand(); break;
+    case input_median_3_killer: {
+      // Musser's sequence defeating median-of-3 pivot selection
+      int k = n / 2;
+      for (int i = 1; i <= k; ++i) {
+        if (i % 2 == 1) { v[i - 1] = i; v[i] = k + i; }
+        v[k + i - 1] = 2 * i;
+      }
+      break;
+    }
+  }
+  return v;
+}
+
+static void BM_select_n_introselect(benchmark::State& state) {
+  std::vector<int> input = select_input(state.range(0), state.range(1));
+  std::vector<int> v;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    v = input;
+    state.ResumeTiming();
+    eop::select_n_introselect(v.begin(), int(v.size()), int(v.size() / 2), std::less<int>());
+  }
+}
+BENCHMARK(BM_select_n_introselect)->ArgPair(1<<10, input_sorted)->ArgPair(1<<20, input_sorted)
+  ->ArgPair(1<<20, input_reversed)->ArgPair(1<<20, input_random)->ArgPair(1<<20, input_median_3_killer);
+
+static void BM_select_n_median_of_medians(benchmark::State& state) {
+  std::vector<int> input = select_input(state.range(0), state.range(1));
+  std::vector<int> v;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    v = input;
+    state.ResumeTiming();
+    eop::select_n_median_of_medians(v.begin(), int(v.size()), int(v.size() / 2), std::less<int>());
+  }
+}
+BENCHMARK(BM_select_n_median_of_medians)->ArgPair(1<<10, input_sorted)->ArgPair(1<<20, input_sorted)
+  ->ArgPair(1<<20, input_reversed)->ArgPair(1<<20, input_random)->ArgPair(1<<20, input_median_3_killer);
+
+static void BM_nth_element_std(benchmark::State& state) {
+  std::vector<int> input = select_input(state.range(0), state.range(1));
+  std::vector<int> v;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    v = input;
+    state.ResumeTiming();
+    std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end(), std::less<int>());
+  }
+}
+BENCHMARK(BM_nth_element_std)->ArgPair(1<<10, input_sorted)->ArgPair(1<<20, input_sorted)
+  ->ArgPair(1<<20, input_reversed)->ArgPair(1<<20, input_random)->ArgPair(1<<20, input_median_3_killer);
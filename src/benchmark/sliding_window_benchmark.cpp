@@ -0,0 +1,89 @@
+#include<algorithm>
+#include<chrono>
+#include<limits>
+#include<random>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "eop.h"
+#include "sliding_window.h"
+
+static const int sliding_window_stream = 1 << 20;
+
+static std::vector<int> stream_input() {
+  std::mt19937 g(9);
+  std::vector<int> x(sliding_window_stream);
+  for (int& a : x) a = int(g() >> 1);
+  return x;
+}
+
+// A window of the last state.range(0) values slides over the stream; each
+// value is pushed, the oldest is dropped and the reduction is read
+
+template<typename Op>
+static void BM_sliding_window(benchmark::State& state) {
+  std::vector<int> x = stream_input();
+  int k = int(state.range(0));
+  eop::sliding_window<Op> w(Op(), Op()(0, 0) == 0 ? 0 : std::numeric_limits<int>::max(), k);
+  for (int i = 0; i < k; ++i) eop::push_back(w, x[i]);
+  int i = 0;
+  while (state.KeepRunning()) {
+    eop::pop_front(w);
+    eop::push_back(w, x[i]);
+    benchmark::DoNotOptimize(eop::reduce(w));
+    i = (i + 1) & (sliding_window_stream - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK_TEMPLATE(BM_sliding_window, eop::plus<int>)->Arg(16)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_sliding_window, eop::minimum<int>)->Arg(16)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_sliding_window_recalculate(benchmark::State& state) {
+  // The reduction of the whole window for each value, for comparison
+  std::vector<int> x = stream_input();
+  int k = int(state.range(0));
+  int i = 0;
+  while (state.KeepRunning()) {
+    int m = std::numeric_limits<int>::max();
+    for (int j = 0; j < k; ++j) {
+      int a = x[(i + j) & (sliding_window_stream - 1)];
+      m = a < m ? a : m;
+    }
+    benchmark::DoNotOptimize(m);
+    i = (i + 1) & (sliding_window_stream - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_sliding_window_recalculate)->Arg(16)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_sliding_window_latency(benchmark::State& state) {
+  // Times each slide on its own and reports quantiles of the times; the
+  // flip of the whole window happens once in state.range(0) slides, and
+  // the maximum is dominated by the scheduler. The clock adds to all
+  typedef std::chrono::steady_clock clock;
+  std::vector<int> x = stream_input();
+  int k = int(state.range(0));
+  eop::sliding_window<eop::minimum<int>> w(eop::minimum<int>(), std::numeric_limits<int>::max(), k);
+  for (int i = 0; i < k; ++i) eop::push_back(w, x[i]);
+  int i = 0;
+  std::vector<float> times;
+  times.reserve(1 << 24);
+  while (state.KeepRunning()) {
+    clock::time_point t0 = clock::now();
+    eop::pop_front(w);
+    eop::push_back(w, x[i]);
+    benchmark::DoNotOptimize(eop::reduce(w));
+    times.push_back(std::chrono::duration<float, std::nano>(clock::now() - t0).count());
+    i = (i + 1) & (sliding_window_stream - 1);
+  }
+  std::sort(times.begin(), times.end());
+  auto quantile = [&](double q) { return times[std::size_t(q * double(times.size() - 1))]; };
+  state.counters["p50_ns"] = quantile(0.5);
+  state.counters["p99.9_ns"] = quantile(0.999);
+  state.counters["p99.999_ns"] = quantile(0.99999);
+  state.counters["max_ns"] = times.back();
+}
+// Register the function as a benchmark
+BENCHMARK(BM_sliding_window_latency)->Arg(16)->Arg(1 << 10)->Arg(1 << 16)->Iterations(1 << 22);
@@ -0,0 +1,74 @@
+#include<algorithm>
+#include<functional>
+#include<random>
+#include<vector>
+
+#include "benchmark/benchmark.h"
+#include "eop.h"
+
+static const int sort_size = 1 << 20;
+
+// state.range(0) picks the input: 0 random, 1 sorted, 2 reversed,
+// 3 few distinct, 4 organ pipe, 5 sorted with 1% out of place
+static std::vector<int> make_sort_input(int k) {
+  std::mt19937 g(5);
+  std::vector<int> x(sort_size);
+  for (int i = 0; i < sort_size; ++i) {
+    switch (k) {
+    case 0: x[i] = int(g() >> 1); break;
+    case 1: x[i] = i; break;
+    case 2: x[i] = sort_size - i; break;
+    case 3: x[i] = int(g() % 16); break;
+    case 4: x[i] = i < sort_size / 2 ? i : sort_size - i; break;
+    default: x[i] = i;
+    }
+  }
+  if (k == 5)
+    for (int i = 0; i < sort_size / 100; ++i) std::swap(x[g() % sort_size], x[g() % sort_size]);
+  return x;
+}
+
+static void BM_sort_n(benchmark::State& state) {
+  std::vector<int> x = make_sort_input(int(state.range(0)));
+  std::vector<int> y(x.size());
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    y = x;
+    state.ResumeTiming();
+    eop::sort_n(y.data(), sort_size, std::less<int>());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * sort_size);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_sort_n)->DenseRange(0, 5)->Unit(benchmark::kMillisecond);
+
+static void BM_std_sort(benchmark::State& state) {
+  std::vector<int> x = make_sort_input(int(state.range(0)));
+  std::vector<int> y(x.size());
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    y = x;
+    state.ResumeTiming();
+    std::sort(y.begin(), y.end(), std::less<int>());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * sort_size);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_std_sort)->DenseRange(0, 5)->Unit(benchmark::kMillisecond);
+
+static void BM_heap_sort_n(benchmark::State& state) {
+  std::vector<int> x = make_sort_input(0);
+  std::vector<int> y(x.size());
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    y = x;
+    state.ResumeTiming();
+    eop::heap_sort_n(y.data(), sort_size, std::less<int>());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * sort_size);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_heap_sort_n)->Unit(benchmark::kMillisecond);
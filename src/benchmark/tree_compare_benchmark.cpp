@@ -0,0 +1,100 @@
+#include "benchmark/benchmark.h"
+#include "eop.h"
+#include "tree.h"
+
+typedef eop::tree_coordinate<long> Coordinate;
+
+// Builds a balanced tree holding the values [f, f + n) in order, with the
+// value changed_key, if present, negated
+static Coordinate build_balanced(long f, long n, long changed_key) {
+  if (n == 0) return Coordinate{ 0 };
+  long h = n / 2;
+  long v = f + h == changed_key ? -(f + h) : f + h;
+  Coordinate c = eop::tree_node_construct<long>{}(v);
+  eop::set_left_successor(c, build_balanced(f, h, changed_key));
+  eop::set_right_successor(c, build_balanced(f + h + 1, n - h - 1, changed_key));
+  return c;
+}
+
+struct balanced_tree
+{
+  Coordinate root;
+  balanced_tree(long n, long changed_key = -1) : root(build_balanced(0, n, changed_key)) {}
+  ~balanced_tree() { eop::bifurcate_erase(root, eop::tree_node_destroy<long>{}); }
+};
+
+// The pair of trees compared: equal, or differing at the last node in
+// preorder, the worst case for an early exit
+static const long tree_size = 1 << 21;
+
+static void BM_bifurcate_equal_serial(benchmark::State& state) {
+  balanced_tree t0(tree_size);
+  balanced_tree t1(tree_size, state.range(0) ? tree_size - 1 : -1);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::bifurcate_equal_nonempty(t0.root, t1.root));
+  }
+  state.SetItemsProcessed(state.iterations() * tree_size);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_bifurcate_equal_serial)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+static void BM_bifurcate_equal_parallel(benchmark::State& state) {
+  balanced_tree t0(tree_size);
+  balanced_tree t1(tree_size, state.range(0) ? tree_size - 1 : -1);
+  int threads = int(state.range(1));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::bifurcate_equal_nonempty_parallel(t0.root, t1.root, threads));
+  }
+  state.SetItemsProcessed(state.iterations() * tree_size);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_bifurcate_equal_parallel)
+  ->ArgPair(0, 1)->ArgPair(0, 2)->ArgPair(0, 4)->ArgPair(0, 8)
+  ->ArgPair(1, 1)->ArgPair(1, 4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_bifurcate_less_parallel(benchmark::State& state) {
+  balanced_tree t0(tree_size);
+  balanced_tree t1(tree_size);
+  int threads = int(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::bifurcate_less_nonempty_parallel(t0.root, t1.root, threads));
+  }
+  state.SetItemsProcessed(state.iterations() * tree_size);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_bifurcate_less_parallel)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_bifurcate_merkle_hashes(benchmark::State& state) {
+  balanced_tree t(tree_size);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::bifurcate_merkle_hashes(t.root).data());
+  }
+  state.SetItemsProcessed(state.iterations() * tree_size);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_bifurcate_merkle_hashes)->Unit(benchmark::kMillisecond);
+
+// Nearly equal trees are told apart by their cached root hashes
+static void BM_bifurcate_equal_hashed(benchmark::State& state) {
+  balanced_tree t0(tree_size);
+  balanced_tree t1(tree_size, tree_size - 1);
+  auto h0 = eop::bifurcate_merkle_hashes(t0.root);
+  auto h1 = eop::bifurcate_merkle_hashes(t1.root);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::bifurcate_equal_hashed(t0.root, h0, t1.root, h1));
+  }
+}
+// Register the function as a benchmark
+BENCHMARK(BM_bifurcate_equal_hashed);
+
+static void BM_bifurcate_mismatch_hashed(benchmark::State& state) {
+  balanced_tree t0(tree_size);
+  balanced_tree t1(tree_size, tree_size - 1);
+  auto h0 = eop::bifurcate_merkle_hashes(t0.root);
+  auto h1 = eop::bifurcate_merkle_hashes(t1.root);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::bifurcate_mismatch_hashed(t0.root, h0, t1.root, h1));
+  }
+}
+// Register the function as a benchmark
+BENCHMARK(BM_bifurcate_mismatch_hashed);
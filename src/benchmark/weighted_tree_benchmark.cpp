@@ -0,0 +1,91 @@
+#include<random>
+
+#include "benchmark/benchmark.h"
+#include "eop.h"
+#include "tree.h"
+
+typedef eop::tree_coordinate<long> Coordinate;
+typedef eop::weighted_tree_coordinate<long> WCoordinate;
+
+// Builds balanced trees holding the values [f, f + n) in order
+static Coordinate build_balanced(long f, long n, Coordinate p) {
+  if (n == 0) return Coordinate{ 0 };
+  long h = n / 2;
+  Coordinate c = eop::tree_node_construct<long>{}(f + h);
+  eop::set_predecessor(c, p);
+  eop::set_left_successor(c, build_balanced(f, h, c));
+  eop::set_right_successor(c, build_balanced(f + h + 1, n - h - 1, c));
+  return c;
+}
+
+static WCoordinate build_weighted_balanced(long f, long n) {
+  if (n == 0) return WCoordinate{ 0 };
+  long h = n / 2;
+  return eop::weighted_tree_node_construct<long>{}(f + h,
+    build_weighted_balanced(f, h), build_weighted_balanced(f + h + 1, n - h - 1));
+}
+
+static void BM_weight_traverse(benchmark::State& state) {
+  Coordinate c = build_balanced(0, state.range(0), Coordinate{ 0 });
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::weight(c));
+  }
+  eop::bifurcate_erase(c, eop::tree_node_destroy<long>{});
+}
+// Register the function as a benchmark
+BENCHMARK(BM_weight_traverse)->Arg(1<<10)->Arg(1<<20);
+
+static void BM_weight_recursive(benchmark::State& state) {
+  Coordinate c = build_balanced(0, state.range(0), Coordinate{ 0 });
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::weight_recursive(c));
+  }
+  eop::bifurcate_erase(c, eop::tree_node_destroy<long>{});
+}
+// Register the function as a benchmark
+BENCHMARK(BM_weight_recursive)->Arg(1<<10)->Arg(1<<20);
+
+static void BM_weight_weighted(benchmark::State& state) {
+  WCoordinate c = build_weighted_balanced(0, state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::weight(c));
+    benchmark::DoNotOptimize(eop::height(c));
+  }
+  eop::bifurcate_erase(c, eop::weighted_tree_node_destroy<long>{});
+}
+// Register the function as a benchmark
+BENCHMARK(BM_weight_weighted)->Arg(1<<10)->Arg(1<<20);
+
+// The k-th node in order found by stepping through the in-order traversal
+static void BM_kth_traverse(benchmark::State& state) {
+  long n = state.range(0);
+  Coordinate c = build_balanced(0, n, Coordinate{ 0 });
+  std::mt19937 g(0);
+  std::uniform_int_distribution<long> d(0, n - 1);
+  while (state.KeepRunning()) {
+    long k = d(g);
+    Coordinate x = c;
+    eop::visit v = eop::visit::pre;
+    while (true) {
+      eop::traverse_step(x, v);
+      if (v == eop::visit::in && k-- == 0) break;
+    }
+    benchmark::DoNotOptimize(x);
+  }
+  eop::bifurcate_erase(c, eop::tree_node_destroy<long>{});
+}
+// Register the function as a benchmark
+BENCHMARK(BM_kth_traverse)->Arg(1<<10)->Arg(1<<16);
+
+static void BM_kth_in_order_select(benchmark::State& state) {
+  long n = state.range(0);
+  WCoordinate c = build_weighted_balanced(0, n);
+  std::mt19937 g(0);
+  std::uniform_int_distribution<int> d(0, int(n) - 1);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(eop::in_order_select(c, d(g)));
+  }
+  eop::bifurcate_erase(c, eop::weighted_tree_node_destroy<long>{});
+}
+// Register the function as a benchmark
+BENCHMARK(BM_kth_in_order_select)->Arg(1<<10)->Arg(1<<16)->Arg(1<<20);
@@ -26,31 +26,98 @@
 
 namespace eop {
 
+	// Each order has its own step, which moves directly to the next
+	// coordinate visited in that order: down a path of successors or up a
+	// path of predecessors, never past root. Over a whole iteration every edge
+	// is traversed at most twice, an amortized constant number of steps per
+	// increment.
+
+	template<typename C>
+		requires(BidirectionalBifurcateCoordinate(C))
+	C first_descendant_post(C c)
+	{
+		// Precondition: !empty(c)
+		while (true) {
+			if (has_left_successor(c)) c = left_successor(c);
+			else if (has_right_successor(c)) c = right_successor(c);
+			else return c;
+		}
+	}
+
+	template<typename C>
+		requires(BidirectionalBifurcateCoordinate(C))
+	C successor_pre(C c, C root)
+	{
+		// Precondition: !empty(c) && c is a descendant of root
+		if (has_left_successor(c)) return left_successor(c);
+		if (has_right_successor(c)) return right_successor(c);
+		while (c != root) {
+			C p = predecessor(c);
+			if (c == left_successor(p) && has_right_successor(p)) return right_successor(p);
+			c = p;
+		}
+		return C{ 0 };
+	}
+
+	template<typename C>
+		requires(BidirectionalBifurcateCoordinate(C))
+	C successor_in(C c, C root)
+	{
+		// Precondition: !empty(c) && c is a descendant of root
+		if (has_right_successor(c)) {
+			c = right_successor(c);
+			while (has_left_successor(c)) c = left_successor(c);
+			return c;
+		}
+		while (c != root) {
+			C p = predecessor(c);
+			if (c == left_successor(p)) return p;
+			c = p;
+		}
+		return C{ 0 };
+	}
+
 	template<typename C>
 		requires(BidirectionalBifurcateCoordinate(C))
-	struct coordinate_iterator : public std::iterator<std::forward_iterator_tag, ValueType(C), WeightType(C)>
+	C successor_post(C c, C root)
+	{
+		// Precondition: !empty(c) && c is a descendant of root
+		if (c == root) return C{ 0 };
+		C p = predecessor(c);
+		if (c == left_successor(p) && has_right_successor(p))
+			return first_descendant_post(right_successor(p));
+		return p;
+	}
+
+	template<typename C>
+		requires(BidirectionalBifurcateCoordinate(C))
+	struct coordinate_iterator : public std::iterator<std::forward_iterator_tag, ValueType(C), WeightType(C),
+	                                                  const ValueType(C)*, const ValueType(C)&>
 	{
 		C root;
 		visit order;
 		C current;
-		coordinate_iterator(C root, visit order = visit::pre) : root(root), order(order) 
+		coordinate_iterator(C root, visit order = visit::pre) : root(root), order(order), current(root)
 		{
-			current = advance_to_first(root, order, root);
+			if (empty(root)) return;
+			if (order == visit::in) {
+				while (has_left_successor(current)) current = left_successor(current);
+			}
+			else if (order == visit::post) current = first_descendant_post(root);
 		}
 		coordinate_iterator<C>(C root, C current, visit order = visit::pre) : root(root), order(order), current(current)
 		{}
 		coordinate_iterator<C>(const coordinate_iterator<C>& x) = default;
 		coordinate_iterator<C>(coordinate_iterator<C>&& x) = default;
-		coordinate_iterator<C>& operator=(const coordinate_iterator<C>& x)
-		{
-			root.ptr = x.root.ptr;
-			order = x.order;
-			current.ptr = x.current.ptr;
-			return *this;
-		}
+		coordinate_iterator<C>& operator=(const coordinate_iterator<C>& x) = default;
 		coordinate_iterator& operator++() 
 		{
-			current = successor_c(current, order);
+			// Precondition: !empty(current)
+			switch (order) {
+			case visit::pre:  current = successor_pre(current, root);  break;
+			case visit::in:   current = successor_in(current, root);   break;
+			case visit::post: current = successor_post(current, root); break;
+			}
 			return *this;
 		}
 		coordinate_iterator operator++(int)
@@ -106,14 +173,15 @@ namespace eop {
 
 	template<typename C>
 		requires(BidirectionalBifurcateCoordinate(C))
-	ValueType(C) source(const coordinate_iterator<C>& c)
+	decltype(auto) source(const coordinate_iterator<C>& c)
 	{
+		// Returns whatever source(C) returns: a reference into the node for tree_coordinate
 		return source(c.current);
 	}
 
 	template<typename C>
 		requires(BidirectionalBifurcateCoordinate(C))
-	ValueType(C) operator*(const coordinate_iterator<C>& c)
+	decltype(auto) operator*(const coordinate_iterator<C>& c)
 	{
 		return source(c);
 	}
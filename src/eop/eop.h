@@ -13,9 +13,30 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <new>
+#include <thread>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
+#if defined(_MSC_VER)
+#include <intrin.h> // _BitScanForward, _byteswap_uint64
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
 #include "intrinsics.h"
 #include "pointers.h"
 #include "type_functions.h"
@@ -860,7 +881,7 @@ namespace eop {
   }
 
   template<typename T>
-  T gcd(T a, T b)
+  T gcd_remainder(T a, T b)
   {
     //Precondition:
     while(true) {
@@ -871,6 +892,202 @@ namespace eop {
     }
   }
 
+  template<typename T>
+  T gcd(T a, T b)
+  {
+    //Precondition:
+    return gcd_remainder(a, b);
+  }
+
+  // Stein's binary gcd replaces the division of gcd_remainder with
+  // shifts and subtractions; count_trailing_zeros strips the factors
+  // of two in a single step on builtin integers.
+
+  template<typename U>
+    requires(Integer(U))
+  int count_trailing_zeros(U x)
+  {
+    // Precondition: x != 0
+    int n = 0;
+    while (even(x)) {
+      x = half_nonnegative(x);
+      n = successor(n);
+    }
+    return n;
+  }
+
+  inline int count_trailing_zeros(unsigned int x)
+  {
+    // Precondition: x != 0
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#elif defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward(&i, x);
+    return int(i);
+#else
+    return count_trailing_zeros<unsigned int>(x);
+#endif
+  }
+
+  inline int count_trailing_zeros(unsigned long x)
+  {
+    // Precondition: x != 0
+#if defined(__GNUC__)
+    return __builtin_ctzl(x);
+#elif defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward(&i, x);
+    return int(i);
+#else
+    return count_trailing_zeros<unsigned long>(x);
+#endif
+  }
+
+  inline int count_trailing_zeros(unsigned long long x)
+  {
+    // Precondition: x != 0
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long i;
+    _BitScanForward64(&i, x);
+    return int(i);
+#else
+    return count_trailing_zeros<unsigned long long>(x);
+#endif
+  }
+
+  template<typename T>
+    requires(Integer(T))
+  T gcd_binary(T a, T b)
+  {
+    // Precondition: a >= 0 && b >= 0
+    typedef typename std::make_unsigned<T>::type U;
+    U u(a);
+    U v(b);
+    if (zero(u)) return b;
+    if (zero(v)) return a;
+    int i = count_trailing_zeros(u);
+    int j = count_trailing_zeros(v);
+    int k = i < j ? i : j;
+    u = u >> i;
+    do {
+      // Invariant: u is odd && v != 0
+      v = v >> count_trailing_zeros(v);
+      U lo = v < u ? v : u; // selections rather than a swap keep
+      U hi = v < u ? u : v; // the loop free of mispredicted branches
+      u = lo;
+      v = hi - lo;
+    } while (!zero(v));
+    return T(u << k);
+  }
+
+  template<typename T>
+    requires(Integer(T))
+  T gcd_binary_magnitude(T a, T b)
+  {
+    // Precondition: gcd(|a|, |b|) is representable in T
+    // Postcondition: returns the nonnegative gcd of a and b
+    typedef typename std::make_unsigned<T>::type U;
+    U u = a < T(0) ? U(0) - U(a) : U(a);
+    U v = b < T(0) ? U(0) - U(b) : U(b);
+    return T(gcd_binary(u, v));
+  }
+
+  template<> inline int                gcd<int>(int a, int b)                               { return gcd_binary_magnitude(a, b); }
+  template<> inline long               gcd<long>(long a, long b)                            { return gcd_binary_magnitude(a, b); }
+  template<> inline long long          gcd<long long>(long long a, long long b)             { return gcd_binary_magnitude(a, b); }
+  template<> inline unsigned int       gcd<unsigned int>(unsigned int a, unsigned int b)    { return gcd_binary(a, b); }
+  template<> inline unsigned long      gcd<unsigned long>(unsigned long a, unsigned long b) { return gcd_binary(a, b); }
+  template<> inline unsigned long long gcd<unsigned long long>(unsigned long long a,
+                                                               unsigned long long b)        { return gcd_binary(a, b); }
+
+  template<typename T>
+    requires(Integer(T))
+  std::tuple<T, T, T> extended_gcd(T a, T b)
+  {
+    // Precondition: a >= 0 && b >= 0
+    // Invariant: a0 * x0 + b0 * y0 == a && a0 * x1 + b0 * y1 == b,
+    //            where a0 and b0 are the original values of a and b
+    T x0(1); T y0(0);
+    T x1(0); T y1(1);
+    while (!zero(b)) {
+      T q = a / b;
+      T r = a - q * b;
+      T x2 = x0 - q * x1;
+      T y2 = y0 - q * y1;
+      a = b;   b = r;
+      x0 = x1; x1 = x2;
+      y0 = y1; y1 = y2;
+    }
+    return std::tuple<T, T, T>(a, x0, y0);
+    // Postcondition: returns (g, x, y) with g == gcd(a, b) && a * x + b * y == g
+  }
+
+  // gcd_n interleaves four independent binary gcds. Every lane advances with
+  // the same branch-free step, which keeps the pipeline busy on scalar code
+  // and lets the compiler map the lanes onto vector registers where the
+  // target has per-lane shifts.
+
+  template<typename U>
+    requires(Integer(U))
+  void gcd_binary_lane_step(U& u, U& v)
+  {
+    // Precondition: u is odd || zero(v)
+    const U top = U(1) << (8 * sizeof(U) - 1);
+    v = v >> count_trailing_zeros(v | top);
+    U lo = v < u ? v : u;
+    U hi = v < u ? u : v;
+    u = zero(v) ? u : lo;
+    v = zero(v) ? v : hi - lo;
+  }
+
+  template<typename I0, typename I1, typename O, typename N>
+    requires(Readable(I0) && Iterator(I0) &&
+             Readable(I1) && Iterator(I1) &&
+             Writable(O) && Iterator(O) &&
+             ValueType(I0) == ValueType(I1) && ValueType(I0) == ValueType(O) &&
+             Integer(ValueType(I0)) && Integer(N))
+  std::tuple<I0, I1, O> gcd_n(I0 f0, I1 f1, N n, O f_o)
+  {
+    // Precondition: readable_counted_range(f0, n) && readable_counted_range(f1, n)
+    // Precondition: writable_counted_range(f_o, n)
+    // Precondition: all the values are nonnegative
+    typedef typename std::remove_cv<typename std::remove_reference<decltype(source(f0))>::type>::type T;
+    typedef typename std::make_unsigned<T>::type U;
+    const int lanes = 4;
+    while (!(n < N(lanes))) {
+      U u[lanes];
+      U v[lanes];
+      int k[lanes];
+      for (int i = 0; i < lanes; ++i) {
+        u[i] = U(source(f0)); f0 = successor(f0);
+        v[i] = U(source(f1)); f1 = successor(f1);
+        // gcd(x, 0) == x: make the odd lane the one that carries the result
+        U w = u[i] | v[i];
+        k[i] = zero(w) ? 0 : count_trailing_zeros(w);
+        if (zero(u[i])) std::swap(u[i], v[i]);
+        u[i] = zero(u[i]) ? u[i] : u[i] >> count_trailing_zeros(u[i]);
+      }
+      while (!zero(v[0] | v[1] | v[2] | v[3]))
+        for (int i = 0; i < lanes; ++i) gcd_binary_lane_step(u[i], v[i]);
+      for (int i = 0; i < lanes; ++i) {
+        sink(f_o) = T(u[i] << k[i]);
+        f_o = successor(f_o);
+      }
+      n = n - N(lanes);
+    }
+    while (!zero(n)) {
+      sink(f_o) = gcd_binary(source(f0), source(f1));
+      f0 = successor(f0);
+      f1 = successor(f1);
+      f_o = successor(f_o);
+      n = predecessor(n);
+    }
+    return std::tuple<I0, I1, O>(f0, f1, f_o);
+  }
+
   // *******************************************************
   // Chapter 6 - Iterators
   // *******************************************************
@@ -1080,6 +1297,16 @@ namespace eop {
     }
   };
 
+  template<typename T>
+  struct negate {
+    typedef T first_argument_type;
+    typedef T result_type;
+    typedef T input_type;
+    T operator()(T a) {
+      return -a;
+    }
+  };
+
   template<typename I>
   struct source_function {
     typedef I first_argument_type;
@@ -1410,6 +1637,143 @@ namespace eop {
     // Postcondition: 
   }
 
+  // Comparing contiguous ranges
+
+  // For pointers to integers, enumerations or pointers, whose values are
+  // equal exactly when their bytes are, find_mismatch with an equality
+  // compares 16 bytes at a time and locates the first differing byte from
+  // the mask of the comparison. lexicographical_compare with the natural
+  // order then compares only the mismatched pair, or calls memcmp for
+  // unsigned bytes, and lexicographical_equal compares the lengths and calls
+  // memcmp.
+
+  template<typename R, typename T>
+  struct is_equality : std::false_type
+  {
+  };
+
+  template<typename T>
+  struct is_equality<is_equal<T>, T> : std::true_type
+  {
+  };
+
+  template<typename T>
+  struct is_equality<std::equal_to<T>, T> : std::true_type
+  {
+  };
+
+  template<typename R, typename T>
+  struct is_natural_order : std::false_type
+  {
+  };
+
+  template<typename T>
+  struct is_natural_order<std::less<T>, T> : std::true_type
+  {
+  };
+
+  template<typename T>
+  struct bytewise_equality :
+    std::integral_constant<bool,
+      std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value>
+  {
+  };
+
+  template<typename T0, typename T1, typename R>
+  struct contiguous_equality :
+    std::integral_constant<bool,
+      std::is_same<typename std::remove_const<T0>::type, typename std::remove_const<T1>::type>::value &&
+      bytewise_equality<typename std::remove_const<T0>::type>::value &&
+      is_equality<R, typename std::remove_const<T0>::type>::value>
+  {
+  };
+
+  template<typename T0, typename T1, typename R>
+  struct contiguous_order :
+    std::integral_constant<bool,
+      std::is_same<typename std::remove_const<T0>::type, typename std::remove_const<T1>::type>::value &&
+      bytewise_equality<typename std::remove_const<T0>::type>::value &&
+      is_natural_order<R, typename std::remove_const<T0>::type>::value>
+  {
+  };
+
+  inline std::size_t mismatch_bytes(const char* x, const char* y, std::size_t n)
+  {
+    // Postcondition: returns the index of the first byte at which
+    // [x, x + n) and [y, y + n) differ, or n if there is none
+    std::size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+    while (i + 32 <= n) {
+      __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+      __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i + 16));
+      __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i));
+      __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i + 16));
+      __m128i e0 = _mm_cmpeq_epi8(a0, b0);
+      __m128i e1 = _mm_cmpeq_epi8(a1, b1);
+      if (_mm_movemask_epi8(_mm_and_si128(e0, e1)) != 0xffff) {
+        unsigned int m = ~unsigned(_mm_movemask_epi8(e0)) & 0xffffu;
+        if (m != 0) return i + std::size_t(count_trailing_zeros(m));
+        m = ~unsigned(_mm_movemask_epi8(e1)) & 0xffffu;
+        return i + 16 + std::size_t(count_trailing_zeros(m));
+      }
+      i = i + 32;
+    }
+    if (i + 16 <= n) {
+      __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+      __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i));
+      unsigned int m = ~unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) & 0xffffu;
+      if (m != 0) return i + std::size_t(count_trailing_zeros(m));
+      i = i + 16;
+    }
+#endif
+    while (i + 8 <= n) {
+      std::uint64_t a;
+      std::uint64_t b;
+      std::memcpy(&a, x + i, 8);
+      std::memcpy(&b, y + i, 8);
+      if (a != b) break;
+      i = i + 8;
+    }
+    while (i != n && x[i] == y[i]) i = i + 1;
+    return i;
+  }
+
+  template<typename T0, typename T1, typename R>
+    requires(Relation(R))
+  std::pair<pointer(T0), pointer(T1)>
+  find_mismatch_contiguous(pointer(T0) f0, pointer(T0) l0, pointer(T1) f1, pointer(T1) l1, R, std::true_type)
+  {
+    // Precondition: readable_bounded_range(f0, l0)
+    // Precondition: readable_bounded_range(f1, l1)
+    std::size_t n = std::size_t(l0 - f0 < l1 - f1 ? l0 - f0 : l1 - f1);
+    std::size_t i = mismatch_bytes(reinterpret_cast<const char*>(f0),
+                                   reinterpret_cast<const char*>(f1), n * sizeof(T0)) / sizeof(T0);
+    return std::make_pair(f0 + i, f1 + i);
+  }
+
+  template<typename T0, typename T1, typename R>
+    requires(Relation(R))
+  std::pair<pointer(T0), pointer(T1)>
+  find_mismatch_contiguous(pointer(T0) f0, pointer(T0) l0, pointer(T1) f1, pointer(T1) l1, R r, std::false_type)
+  {
+    // Precondition: readable_bounded_range(f0, l0)
+    // Precondition: readable_bounded_range(f1, l1)
+    while (f0 != l0 && f1 != l1 && r(source(f0), source(f1))) {
+      f0 = successor(f0);
+      f1 = successor(f1);
+    }
+    return std::make_pair(f0, f1);
+  }
+
+  template<typename T0, typename T1, typename R>
+    requires(Relation(R))
+  std::pair<pointer(T0), pointer(T1)> find_mismatch(pointer(T0) f0, pointer(T0) l0, pointer(T1) f1, pointer(T1) l1, R r)
+  {
+    // Precondition: readable_bounded_range(f0, l0)
+    // Precondition: readable_bounded_range(f1, l1)
+    return find_mismatch_contiguous(f0, l0, f1, l1, r, contiguous_equality<T0, T1, R>());
+  }
+
   template<typename I, typename R>
   requires(Readable(I) && Iterator(I) && Relation(R) &&
     ValueType(I) == Domain(R))
@@ -1573,6 +1937,24 @@ namespace eop {
     return partition_point_n(f, n, p);
   }
 
+  template<typename T, typename R>
+  requires(Readable(T) && Relation(R) && T == Domain(R))
+  pointer(T) lower_bound_n(pointer(T) f, DistanceType(pointer(T)) n, const T& a, R r)
+  {
+    // Precondition: weak_increasing(r) && increasing_counted_range(f, n, r)
+    lower_bound_predicate<R> p(a, r);
+    return partition_point_n(f, n, p);
+  }
+
+  template<typename T, typename R>
+  requires(Readable(T) && Relation(R) && T == Domain(R))
+  pointer(T) upper_bound_n(pointer(T) f, DistanceType(pointer(T)) n, const T& a, R r)
+  {
+    // Precondition: weak_increasing(r) && increasing_counted_range(f, n, r)
+    upper_bound_predicate<R> p(a, r);
+    return partition_point_n(f, n, p);
+  }
+
   template<typename I, typename R>
   requires(ForwardIterator(I) && Readable(R) && Relation(R) &&
     ValueType(I) == Domain(R))
@@ -1640,6 +2022,19 @@ namespace eop {
     return l;
   }
 
+  template<typename I, typename P>
+  requires(Readable(I) && BidirectionalIterator(I) && UnaryPredicate(P) &&
+    ValueType(I) == Domain(P))
+  I find_backward_if_not(I f, I l, P p)
+  {
+    // Precondition: (f, l] is a readable bounde half-open on left range
+    I i = l;
+    while (f != l && (i = predecessor(i), p(source(i)))) {
+      l = i;
+    }
+    return l;
+  }
+
   // incomplete
   template<typename I>
     requires(BidirectionalIterator(I))
@@ -2022,6 +2417,11 @@ namespace eop {
     }
   };
 
+  template<typename T>
+  struct is_equality<equal<T>, T> : std::true_type
+  {
+  };
+
   template<typename I0, typename I1>
   requires(Readable(I0) && Iterator(I0) &&
     Readable(I1) && Iterator(I1) &&
@@ -2031,6 +2431,28 @@ namespace eop {
     return lexicograpical_equivalent(f0, l0, f1, l1, equal<ValueType(I0)>());
   }
 
+  template<typename T0, typename T1>
+  bool lexicographical_equal_contiguous(pointer(T0) f0, pointer(T0) l0, pointer(T1) f1, pointer(T1) l1,
+                                        std::true_type)
+  {
+    return l0 - f0 == l1 - f1 &&
+      (f0 == l0 || std::memcmp(f0, f1, std::size_t(l0 - f0) * sizeof(T0)) == 0);
+  }
+
+  template<typename T0, typename T1>
+  bool lexicographical_equal_contiguous(pointer(T0) f0, pointer(T0) l0, pointer(T1) f1, pointer(T1) l1,
+                                        std::false_type)
+  {
+    return lexicograpical_equivalent(f0, l0, f1, l1, equal<typename std::remove_const<T0>::type>());
+  }
+
+  template<typename T0, typename T1>
+  bool lexicographical_equal(pointer(T0) f0, pointer(T0) l0, pointer(T1) f1, pointer(T1) l1)
+  {
+    typedef equal<typename std::remove_const<T0>::type> E;
+    return lexicographical_equal_contiguous(f0, l0, f1, l1, contiguous_equality<T0, T1, E>());
+  }
+
   template<typename C0, typename C1,
     typename R>
   requires(Readable(C0) && BifurcateCoordinate(C0) &&
@@ -2117,7 +2539,7 @@ namespace eop {
     Relation(R) &&
     ValueType(I0) == ValueType(I1) &&
     ValueType(I0) == Domain(R))
-  bool lexicograpichal_compare(I0 f0, I0 l0, I1 f1, I1 l1, R r)
+  bool lexicographical_compare(I0 f0, I0 l0, I1 f1, I1 l1, R r)
   {
     // Precondition: readable_bounded_range(f0, l0)
     // Precondition: readable_bounded_range(f1, l1)
@@ -2132,22 +2554,74 @@ namespace eop {
     }
   }
 
+  template<typename T0, typename T1, typename R>
+    requires(Relation(R))
+  bool lexicographical_compare_contiguous(pointer(T0) f0, pointer(T0) l0, pointer(T1) f1, pointer(T1) l1,
+                                          R r, std::true_type)
+  {
+    // Precondition: readable_bounded_range(f0, l0)
+    // Precondition: readable_bounded_range(f1, l1)
+    // The order of unsigned bytes is the order of memcmp
+    std::size_t n = std::size_t(l0 - f0 < l1 - f1 ? l0 - f0 : l1 - f1);
+    if (sizeof(T0) == 1 && std::is_unsigned<typename std::remove_const<T0>::type>::value) {
+      int c = n == 0 ? 0 : std::memcmp(f0, f1, n);
+      if (c != 0) return c < 0;
+      return l0 - f0 < l1 - f1;
+    }
+    std::size_t i = mismatch_bytes(reinterpret_cast<const char*>(f0),
+                                   reinterpret_cast<const char*>(f1), n * sizeof(T0)) / sizeof(T0);
+    if (i != n) return r(f0[i], f1[i]);
+    return l0 - f0 < l1 - f1;
+  }
+
+  template<typename T0, typename T1, typename R>
+    requires(Relation(R))
+  bool lexicographical_compare_contiguous(pointer(T0) f0, pointer(T0) l0, pointer(T1) f1, pointer(T1) l1,
+                                          R r, std::false_type)
+  {
+    return eop::lexicographical_compare<pointer(T0), pointer(T1), R>(f0, l0, f1, l1, r);
+  }
+
+  template<typename T0, typename T1, typename R>
+    requires(Relation(R))
+  bool lexicographical_compare(pointer(T0) f0, pointer(T0) l0, pointer(T1) f1, pointer(T1) l1, R r)
+  {
+    // Precondition: readable_bounded_range(f0, l0)
+    // Precondition: readable_bounded_range(f1, l1)
+    // weak_ordering(r)
+    return lexicographical_compare_contiguous(f0, l0, f1, l1, r, contiguous_order<T0, T1, R>());
+  }
+
   template<typename T>
     requires(TotallyOrdered(T))
   struct less 
   {
+    typedef T first_argument_type;
+    typedef T second_argument_type;
+    typedef bool result_type;
     bool operator()(const T& x, const T& y)
     {
       return x < y;
     }
   };
 
+  template<typename T>
+  struct is_natural_order<less<T>, T> : std::true_type
+  {
+  };
+
   template<typename I0, typename I1>
   requires(Readable(I0) && Iterator(I0) &&
     Readable(I1) && Iterator(I1))
-  bool lexicograpichal_less(I0 f0, I0 l0, I1 f1, I1 l1)
+  bool lexicographical_less(I0 f0, I0 l0, I1 f1, I1 l1)
+  {
+    return eop::lexicographical_compare(f0, l0, f1, l1, less <ValueType(I0)>());
+  }
+
+  template<typename T0, typename T1>
+  bool lexicographical_less(pointer(T0) f0, pointer(T0) l0, pointer(T1) f1, pointer(T1) l1)
   {
-    return lexicographical_compare(f0, l0, f1, l1, less <ValueType(I0)>());
+    return eop::lexicographical_compare(f0, l0, f1, l1, less<typename std::remove_const<T0>::type>());
   }
 
   enum class comparison { less, equal, greater };
@@ -2242,77 +2716,534 @@ namespace eop {
     return bifurcate_compare(c0, c1, less<ValueType(C0)>());
   }
 
+  // Parallel comparison of trees
+
+  // The comparisons above visit the nodes in preorder and stop at the first
+  // difference. The parallel versions expand both trees in lockstep down to
+  // split depth, comparing the nodes above it, and collect in preorder the
+  // pairs of subtrees at it as tasks. A pool of threads takes the tasks in
+  // order and the result is that of the first task that differs; a thread
+  // stops taking tasks once a difference is known before them. Parallelism
+  // comes from the subtrees at split depth, so a degenerate tree is compared
+  // by few threads.
+
+  inline int default_thread_count()
+  {
+    // Queried once, as hardware_concurrency may read the system configuration
+    static const int n = int(std::thread::hardware_concurrency());
+    return n < 1 ? 1 : n;
+  }
+
+  inline int bifurcate_split_depth(int threads)
+  {
+    // About eight tasks a thread for a balanced tree
+    int depth = 3;
+    while (threads > 1) {
+      ++depth;
+      threads = half_nonnegative(threads);
+    }
+    return depth;
+  }
+
+  template<typename C0, typename C1, typename N>
+    requires(BifurcateCoordinate(C0) && BifurcateCoordinate(C1) &&
+      Arity(N) == 2 && Codomain(N) == comparison)
+  comparison bifurcate_split_nonempty(C0 c0, C1 c1, N node, int depth,
+                                      std::vector<std::pair<C0, C1>>& tasks)
+  {
+    // Precondition: !empty(c0) && !empty(c1)
+    // Postcondition: the first difference found above depth ends the split
+    // and is returned; the tasks collected before it still have to be compared
+    if (depth == 0) {
+      tasks.push_back(std::pair<C0, C1>(c0, c1));
+      return comparison::equal;
+    }
+    comparison c = node(c0, c1);
+    if (c != comparison::equal) return c;
+    if (has_left_successor(c0) != has_left_successor(c1))
+      return has_left_successor(c0) ? comparison::greater : comparison::less;
+    if (has_left_successor(c0)) {
+      c = bifurcate_split_nonempty(left_successor(c0), left_successor(c1), node, depth - 1, tasks);
+      if (c != comparison::equal) return c;
+    }
+    if (has_right_successor(c0) != has_right_successor(c1))
+      return has_right_successor(c0) ? comparison::greater : comparison::less;
+    if (has_right_successor(c0))
+      return bifurcate_split_nonempty(right_successor(c0), right_successor(c1), node, depth - 1, tasks);
+    return comparison::equal;
+  }
+
+  template<typename C0, typename C1, typename F>
+    requires(BifurcateCoordinate(C0) && BifurcateCoordinate(C1) &&
+      Arity(F) == 2 && Codomain(F) == comparison)
+  comparison bifurcate_compare_tasks(const std::vector<std::pair<C0, C1>>& tasks, F subtree, int threads)
+  {
+    // Precondition: 0 < threads
+    // Postcondition: returns the result of the first task that differs
+    std::size_t n = tasks.size();
+    std::vector<comparison> results(n, comparison::equal);
+    std::atomic<std::size_t> next(0);
+    std::atomic<std::size_t> first(n);
+    auto work = [&]() {
+      F f = subtree;
+      while (true) {
+        std::size_t i = next++;
+        if (i >= n || first.load() < i) return;
+        comparison c = f(tasks[i].first, tasks[i].second);
+        if (c == comparison::equal) continue;
+        results[i] = c;
+        std::size_t j = first.load();
+        while (i < j && !first.compare_exchange_weak(j, i));
+      }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads && std::size_t(t) < n; ++t) pool.emplace_back(work);
+    work();
+    for (std::thread& t : pool) t.join();
+    std::size_t i = first.load();
+    return i < n ? results[i] : comparison::equal;
+  }
+
+  template<typename C0, typename C1, typename N, typename F>
+    requires(BifurcateCoordinate(C0) && BifurcateCoordinate(C1) &&
+      Arity(N) == 2 && Codomain(N) == comparison &&
+      Arity(F) == 2 && Codomain(F) == comparison)
+  comparison bifurcate_compare_nonempty_parallel_3_way(C0 c0, C1 c1, N node, F subtree, int threads)
+  {
+    // Precondition: !empty(c0) && !empty(c1) && 0 < threads
+    std::vector<std::pair<C0, C1>> tasks;
+    comparison c = bifurcate_split_nonempty(c0, c1, node, bifurcate_split_depth(threads), tasks);
+    comparison t = bifurcate_compare_tasks(tasks, subtree, threads);
+    return t != comparison::equal ? t : c;
+  }
 
-  // Exercise 7.6 (copied)
   template<typename R>
     requires(Relation(R))
-  struct comparator_3_way
+  struct bifurcate_compare_node
   {
-    typedef Domain(R) T;
     R r;
-    comparator_3_way(R r) : r(r)
-    {
-      // Precondition: $\property{weak\_ordering}(r)$
-      // Postcondition: three_way_compare(comparator_3_way(r))
-    }
-    int operator()(const T& a, const T& b)
+    template<typename C0, typename C1>
+    comparison operator()(C0 c0, C1 c1)
     {
-      if (r(a, b)) return 1;
-      if (r(b, a)) return -1;
-      return 0;
+      if (r(source(c0), source(c1))) return comparison::less;
+      if (r(source(c1), source(c0))) return comparison::greater;
+      return comparison::equal;
     }
   };
 
-  //
-  // Chapter 8  - Link Rearrangements
-  //
-
-  template<typename I>
-    requires(LinkedForwardIterator(I))
-  struct forward_linker
+  template<typename R>
+    requires(Relation(R))
+  struct bifurcate_compare_subtree
   {
-    void operator()(I& x, I& y) const
+    R r;
+    template<typename C0, typename C1>
+    comparison operator()(C0 c0, C1 c1)
     {
-      sink(x.ptr).forward_link = y.ptr;
+      return bifurcate_compare_nonempty_recursive(c0, c1, r);
     }
   };
 
-  template<typename I>
-    requires(LinkedForwardIterator(I))
-  struct iterator_type<forward_linker<I>>
+  // An equivalence only tells equal from not equal; not equal is reported
+  // as less
+
+  template<typename R>
+    requires(Relation(R))
+  struct bifurcate_equivalent_node
   {
-    typedef I type;
+    R r;
+    template<typename C0, typename C1>
+    comparison operator()(C0 c0, C1 c1)
+    {
+      return r(source(c0), source(c1)) ? comparison::equal : comparison::less;
+    }
   };
 
-  template<typename I>
-    requires(LinkedBidirectionalIterator(I))
-  struct backward_linker
+  template<typename R>
+    requires(Relation(R))
+  struct bifurcate_equivalent_subtree
   {
-    void operator()(I& x, I& y)
+    R r;
+    template<typename C0, typename C1>
+    comparison operator()(C0 c0, C1 c1)
     {
-      sink(y.ptr).backward_link = x.ptr;
+      return bifurcate_equivalent_nonempty(c0, c1, r) ? comparison::equal : comparison::less;
     }
   };
 
-  template<typename I>
-    requires(LinkedBidirectionalIterator)
-  struct iterator_type<backward_linker<I>>
+  struct bifurcate_isomorphic_node
   {
-    typedef I type; 
+    template<typename C0, typename C1>
+    comparison operator()(C0, C1) { return comparison::equal; }
   };
 
-  template<typename I>
-    requires(LinkedBidirectionalIterator(I))
-  struct bidirectional_linker
+  struct bifurcate_isomorphic_subtree
   {
-    void operator()(I& x, I& y)
+    template<typename C0, typename C1>
+    comparison operator()(C0 c0, C1 c1)
     {
-      forward_linker<I>()(x, y);
-      backward_linker<I>()(x, y);
+      return bifurcate_isomorphic_nonempty(c0, c1) ? comparison::equal : comparison::less;
     }
   };
 
-  template<typename   I>
+  template<typename C0, typename C1>
+    requires(BifurcateCoordinate(C0) && BifurcateCoordinate(C1))
+  bool bifurcate_isomorphic_nonempty_parallel(C0 c0, C1 c1, int threads = default_thread_count())
+  {
+    // Precondition: !empty(c0) && !empty(c1) && 0 < threads
+    return bifurcate_compare_nonempty_parallel_3_way(c0, c1,
+      bifurcate_isomorphic_node(), bifurcate_isomorphic_subtree(), threads) == comparison::equal;
+  }
+
+  template<typename C0, typename C1, typename R>
+  requires(Readable(C0) && BifurcateCoordinate(C0) &&
+    Readable(C1) && BifurcateCoordinate(C1) &&
+    Relation(R) &&
+    ValueType(C0) == ValueType(C1) &&
+    ValueType(C0) == Domain(R))
+  bool bifurcate_equivalent_nonempty_parallel(C0 c0, C1 c1, R r, int threads = default_thread_count())
+  {
+    // Precondition: readable_tree(c0) && readable_tree(c1)
+    // Precondition: !empty(c0) && !empty(c1) && 0 < threads
+    // Precondition: equivalence(r)
+    return bifurcate_compare_nonempty_parallel_3_way(c0, c1,
+      bifurcate_equivalent_node<R>{r}, bifurcate_equivalent_subtree<R>{r}, threads) == comparison::equal;
+  }
+
+  template<typename C0, typename C1>
+  requires(Readable(C0) && BifurcateCoordinate(C0) &&
+    Readable(C1) && BifurcateCoordinate(C1) &&
+    ValueType(C0) == ValueType(C1))
+  bool bifurcate_equal_nonempty_parallel(C0 c0, C1 c1, int threads = default_thread_count())
+  {
+    // Precondition: readable_tree(c0) && readable_tree(c1)
+    // Precondition: !empty(c0) && !empty(c1) && 0 < threads
+    typedef typename std::decay<decltype(source(c0))>::type T;
+    return bifurcate_equivalent_nonempty_parallel(c0, c1, equal<T>(), threads);
+  }
+
+  template<typename C0, typename C1, typename R>
+  requires(BifurcateCoordinate(C0) && Readable(C0) &&
+    BifurcateCoordinate(C1) && Readable(C1) &&
+    Relation(R) &&
+    ValueType(C0) == ValueType(C1) &&
+    ValueType(C0) == Domain(R))
+  bool bifurcate_compare_nonempty_parallel(C0 c0, C1 c1, R r, int threads = default_thread_count())
+  {
+    // Precondition: readable_tree(c0) && readable_tree(c1)
+    // Precondition: !empty(c0) && !empty(c1) && 0 < threads
+    // Precondition: weak_ordering(r)
+    return bifurcate_compare_nonempty_parallel_3_way(c0, c1,
+      bifurcate_compare_node<R>{r}, bifurcate_compare_subtree<R>{r}, threads) == comparison::less;
+  }
+
+  template<typename C0, typename C1>
+  requires(BifurcateCoordinate(C0) && Readable(C0) &&
+    BifurcateCoordinate(C1) && Readable(C1) &&
+    ValueType(C0) == ValueType(C1))
+  bool bifurcate_less_nonempty_parallel(C0 c0, C1 c1, int threads = default_thread_count())
+  {
+    typedef typename std::decay<decltype(source(c0))>::type T;
+    return bifurcate_compare_nonempty_parallel(c0, c1, less<T>(), threads);
+  }
+
+  // Parallel comparison of ranges
+
+  // find_mismatch_parallel splits the common length of two random access
+  // ranges into blocks of parallel_compare_block_bytes, which a pool of
+  // threads compares in order like the tasks of the tree comparisons: a
+  // thread stops taking blocks once a mismatch is known before them, so
+  // after the first mismatch each thread compares at most one more block.
+  // Each block is compared by find_mismatch, with the vectorised search for
+  // contiguous ranges of integers. Ranges shorter than two blocks are
+  // compared by the calling thread.
+
+  const std::size_t parallel_compare_block_bytes = std::size_t(1) << 20;
+
+  template<typename R>
+    requires(Relation(R))
+  struct symmetric_complement
+  {
+    R r;
+    template<typename T>
+    bool operator()(const T& a, const T& b)
+    {
+      return !r(a, b) && !r(b, a);
+    }
+  };
+
+  template<typename I0, typename I1, typename R>
+    requires(Readable(I0) && RandomAccessIterator(I0) &&
+      Readable(I1) && RandomAccessIterator(I1) && Relation(R) &&
+      ValueType(I0) == ValueType(I1) && ValueType(I0) == Domain(R))
+  std::pair<I0, I1> find_mismatch_parallel(I0 f0, I0 l0, I1 f1, I1 l1, R r,
+                                           int threads = default_thread_count())
+  {
+    // Precondition: readable_bounded_range(f0, l0)
+    // Precondition: readable_bounded_range(f1, l1)
+    // Precondition: 0 < threads
+    typedef typename std::decay<decltype(source(f0))>::type T;
+    std::size_t n = std::size_t(l0 - f0 < l1 - f1 ? l0 - f0 : l1 - f1);
+    std::size_t b = parallel_compare_block_bytes < sizeof(T) ? 1 : parallel_compare_block_bytes / sizeof(T);
+    std::size_t blocks = (n + b - 1) / b;
+    if (threads < 2 || blocks < 2) return find_mismatch(f0, l0, f1, l1, r);
+    std::atomic<std::size_t> next(0);
+    std::atomic<std::size_t> first(n);
+    auto work = [&]() {
+      R s = r;
+      while (true) {
+        std::size_t k = next++;
+        if (k >= blocks || first.load() <= k * b) return;
+        std::ptrdiff_t i = std::ptrdiff_t(k * b);
+        std::ptrdiff_t m = std::ptrdiff_t(n - k * b < b ? n - k * b : b);
+        std::ptrdiff_t j = find_mismatch(f0 + i, f0 + (i + m), f1 + i, f1 + (i + m), s).first - f0;
+        if (j == i + m) continue;
+        std::size_t x = first.load();
+        while (std::size_t(j) < x && !first.compare_exchange_weak(x, std::size_t(j)));
+      }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads && std::size_t(t) < blocks; ++t) pool.emplace_back(work);
+    work();
+    for (std::thread& t : pool) t.join();
+    std::ptrdiff_t i = std::ptrdiff_t(first.load());
+    return std::make_pair(f0 + i, f1 + i);
+  }
+
+  template<typename I0, typename I1>
+    requires(Readable(I0) && RandomAccessIterator(I0) &&
+      Readable(I1) && RandomAccessIterator(I1) &&
+      ValueType(I0) == ValueType(I1))
+  bool lexicographical_equal_parallel(I0 f0, I0 l0, I1 f1, I1 l1, int threads = default_thread_count())
+  {
+    typedef typename std::decay<decltype(source(f0))>::type T;
+    if (l0 - f0 != l1 - f1) return false;
+    return find_mismatch_parallel(f0, l0, f1, l1, equal<T>(), threads).first == l0;
+  }
+
+  template<typename I0, typename I1, typename R>
+    requires(Readable(I0) && RandomAccessIterator(I0) &&
+      Readable(I1) && RandomAccessIterator(I1) && Relation(R) &&
+      ValueType(I0) == ValueType(I1) && ValueType(I0) == Domain(R))
+  bool lexicographical_compare_parallel(I0 f0, I0 l0, I1 f1, I1 l1, R r,
+                                        int threads = default_thread_count())
+  {
+    // Precondition: weak_ordering(r)
+    std::pair<I0, I1> p = find_mismatch_parallel(f0, l0, f1, l1, symmetric_complement<R>{ r }, threads);
+    if (p.second == l1) return false;
+    if (p.first == l0) return true;
+    return r(source(p.first), source(p.second));
+  }
+
+  template<typename I0, typename I1>
+    requires(Readable(I0) && RandomAccessIterator(I0) &&
+      Readable(I1) && RandomAccessIterator(I1) &&
+      ValueType(I0) == ValueType(I1) && TotallyOrdered(ValueType(I0)))
+  bool lexicographical_less_parallel(I0 f0, I0 l0, I1 f1, I1 l1, int threads = default_thread_count())
+  {
+    // Under a total ordering equivalence is equality, so the search for the
+    // mismatch is that of lexicographical_equal_parallel
+    typedef typename std::decay<decltype(source(f0))>::type T;
+    std::pair<I0, I1> p = find_mismatch_parallel(f0, l0, f1, l1, equal<T>(), threads);
+    if (p.second == l1) return false;
+    if (p.first == l0) return true;
+    return source(p.first) < source(p.second);
+  }
+
+  // Merkle hashes of trees
+
+  // The Merkle hash of a tree combines the hash of the value at its root
+  // with the Merkle hashes of its subtrees, so trees with different hashes
+  // differ. bifurcate_merkle_hashes records the hash and weight of every
+  // subtree in preorder; the subtrees of the node at index i are at i + 1
+  // and at i + 1 + the weight of its left subtree. The hashes of a tree
+  // that is not modified are computed once and reused by every comparison.
+
+  template<typename W>
+    requires(Integer(W))
+  struct merkle_hash
+  {
+    std::uint64_t hash;
+    W weight;
+  };
+
+  inline std::uint64_t hash_combine(std::uint64_t seed, std::uint64_t x)
+  {
+    // The splitmix64 finalizer applied to the combination
+    x = seed ^ (x + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+  }
+
+  template<typename C, typename H>
+    requires(Readable(C) && BifurcateCoordinate(C) &&
+      UnaryFunction(H) && ValueType(C) == Domain(H))
+  std::uint64_t bifurcate_merkle_hashes_nonempty(C c, H& h, std::vector<merkle_hash<WeightType(C)>>& hashes)
+  {
+    // Precondition: tree(c) && !empty(c)
+    typedef WeightType(C) N;
+    std::size_t i = hashes.size();
+    hashes.push_back(merkle_hash<N>{ 0, N(1) });
+    std::uint64_t l = 0;
+    std::uint64_t r = 0;
+    N n(1);
+    if (has_left_successor(c)) {
+      l = bifurcate_merkle_hashes_nonempty(left_successor(c), h, hashes);
+      n = n + hashes[i + 1].weight;
+    }
+    if (has_right_successor(c)) {
+      std::size_t j = hashes.size();
+      r = bifurcate_merkle_hashes_nonempty(right_successor(c), h, hashes);
+      n = n + hashes[j].weight;
+    }
+    std::uint64_t x = hash_combine(hash_combine(std::uint64_t(h(source(c))), l), r);
+    hashes[i] = merkle_hash<N>{ x, n };
+    return x;
+  }
+
+  template<typename C, typename H>
+    requires(Readable(C) && BifurcateCoordinate(C) &&
+      UnaryFunction(H) && ValueType(C) == Domain(H))
+  std::vector<merkle_hash<WeightType(C)>> bifurcate_merkle_hashes(C c, H h)
+  {
+    // Precondition: tree(c)
+    std::vector<merkle_hash<WeightType(C)>> hashes;
+    if (!empty(c)) bifurcate_merkle_hashes_nonempty(c, h, hashes);
+    return hashes;
+  }
+
+  template<typename C>
+    requires(Readable(C) && BifurcateCoordinate(C))
+  std::vector<merkle_hash<WeightType(C)>> bifurcate_merkle_hashes(C c)
+  {
+    typedef typename std::decay<decltype(source(c))>::type T;
+    return bifurcate_merkle_hashes(c, std::hash<T>());
+  }
+
+  template<typename C0, typename C1, typename W>
+  requires(Readable(C0) && BifurcateCoordinate(C0) &&
+    Readable(C1) && BifurcateCoordinate(C1) &&
+    ValueType(C0) == ValueType(C1))
+  bool bifurcate_equal_hashed(C0 c0, const std::vector<merkle_hash<W>>& h0,
+                              C1 c1, const std::vector<merkle_hash<W>>& h1,
+                              int threads = default_thread_count())
+  {
+    // Precondition: h0 and h1 are the Merkle hashes of c0 and c1
+    // Trees with different hashes are told apart in constant time; trees
+    // with equal hashes are compared in full
+    if (empty(c0)) return empty(c1);
+    if (empty(c1)) return false;
+    if (h0[0].hash != h1[0].hash || h0[0].weight != h1[0].weight) return false;
+    return bifurcate_equal_nonempty_parallel(c0, c1, threads);
+  }
+
+  template<typename C0, typename C1, typename W>
+  requires(Readable(C0) && BifurcateCoordinate(C0) &&
+    Readable(C1) && BifurcateCoordinate(C1) &&
+    ValueType(C0) == ValueType(C1))
+  std::pair<C0, C1> bifurcate_mismatch_hashed(C0 c0, const std::vector<merkle_hash<W>>& h0,
+                                              C1 c1, const std::vector<merkle_hash<W>>& h1)
+  {
+    // Precondition: h0 and h1 are the Merkle hashes of c0 and c1
+    // Precondition: !empty(c0) && !empty(c1)
+    // Postcondition: returns the first nodes in preorder whose values or
+    // whose successors differ, or a pair of empty coordinates when the
+    // hashes are equal; subtrees with equal hashes are taken to be equal,
+    // so the time is linear in the height of the trees
+    typedef std::pair<C0, C1> P;
+    if (h0[0].hash == h1[0].hash) return P(C0(), C1());
+    std::size_t i0 = 0;
+    std::size_t i1 = 0;
+    while (true) {
+      if (!(source(c0) == source(c1)) ||
+          has_left_successor(c0) != has_left_successor(c1) ||
+          has_right_successor(c0) != has_right_successor(c1))
+        return P(c0, c1);
+      if (has_left_successor(c0) && h0[i0 + 1].hash != h1[i1 + 1].hash) {
+        c0 = left_successor(c0);
+        c1 = left_successor(c1);
+        i0 = i0 + 1;
+        i1 = i1 + 1;
+      } else if (has_right_successor(c0)) {
+        i0 = i0 + 1 + (has_left_successor(c0) ? std::size_t(h0[i0 + 1].weight) : 0);
+        i1 = i1 + 1 + (has_left_successor(c1) ? std::size_t(h1[i1 + 1].weight) : 0);
+        c0 = right_successor(c0);
+        c1 = right_successor(c1);
+      } else return P(c0, c1);
+    }
+  }
+
+
+  // Exercise 7.6 (copied)
+  template<typename R>
+    requires(Relation(R))
+  struct comparator_3_way
+  {
+    typedef Domain(R) T;
+    R r;
+    comparator_3_way(R r) : r(r)
+    {
+      // Precondition: $\property{weak\_ordering}(r)$
+      // Postcondition: three_way_compare(comparator_3_way(r))
+    }
+    int operator()(const T& a, const T& b)
+    {
+      if (r(a, b)) return 1;
+      if (r(b, a)) return -1;
+      return 0;
+    }
+  };
+
+  //
+  // Chapter 8  - Link Rearrangements
+  //
+
+  template<typename I>
+    requires(LinkedForwardIterator(I))
+  struct forward_linker
+  {
+    void operator()(I& x, I& y) const
+    {
+      sink(x.ptr).forward_link = y.ptr;
+    }
+  };
+
+  template<typename I>
+    requires(LinkedForwardIterator(I))
+  struct iterator_type<forward_linker<I>>
+  {
+    typedef I type;
+  };
+
+  template<typename I>
+    requires(LinkedBidirectionalIterator(I))
+  struct backward_linker
+  {
+    void operator()(I& x, I& y) const
+    {
+      sink(y.ptr).backward_link = x.ptr;
+    }
+  };
+
+  template<typename I>
+    requires(LinkedBidirectionalIterator)
+  struct iterator_type<backward_linker<I>>
+  {
+    typedef I type; 
+  };
+
+  template<typename I>
+    requires(LinkedBidirectionalIterator(I))
+  struct bidirectional_linker
+  {
+    void operator()(I& x, I& y) const
+    {
+      forward_linker<I>()(x, y);
+      backward_linker<I>()(x, y);
+    }
+  };
+
+  template<typename   I>
     requires(LinkedBidirectionalIterator)
   struct iterator_type<bidirectional_linker<I>>
   {
@@ -2482,6 +3413,8 @@ namespace eop {
     ValueType(I0) == Domain(R))
   struct relation_source
   {
+    typedef I0 first_argument_type;
+    typedef I1 second_argument_type;
     R r;
     relation_source(R r) : r(r) {}
     bool operator()(I0 i0, I1 i1)
@@ -2543,10 +3476,11 @@ namespace eop {
   {
     std::pair<I, I> p = sort_linked_nonempty_n(f, n, r, forward_linker<I>());
     f = p.first;
-    while(f != p.second) { 
-      set_backward_link(f, successor(f)); 
-      f = sucessor(f); 
+    while(successor(f) != p.second) {
+      set_backward_link(f, successor(f));
+      f = successor(f);
     }
+    if (!empty(p.second)) set_backward_link(f, p.second);
     return p;
   }
 
@@ -2747,6 +3681,192 @@ namespace eop {
     return std::make_pair(l_i, l_o);
   }
 
+  // Copying contiguous ranges
+
+  // For pointers to trivially copyable types copy_n, copy_bounded and
+  // copy_backward_n forward to memmove, which moves whole vector registers.
+  // copy_n_streaming and copy_backward_n_streaming in addition write ranges
+  // of at least streaming_copy_threshold_bytes that don't overlap with
+  // non-temporal stores: these go to memory without evicting the working
+  // set from the cache, for destinations that are not read again soon.
+
+  const std::size_t streaming_copy_threshold_bytes = std::size_t(1) << 23;
+
+  template<typename T0, typename T1>
+  struct contiguous_copyable :
+    std::integral_constant<bool,
+      std::is_same<typename std::remove_const<T0>::type, T1>::value &&
+      std::is_trivially_copyable<T1>::value>
+  {
+  };
+
+  template<typename T0, typename T1>
+  struct contiguous_compactable :
+    std::integral_constant<bool,
+      contiguous_copyable<T0, T1>::value && std::is_arithmetic<T1>::value>
+  {
+  };
+
+  inline bool disjoint_bytes(const void* x, const void* y, std::size_t n)
+  {
+    std::uintptr_t a = reinterpret_cast<std::uintptr_t>(x);
+    std::uintptr_t b = reinterpret_cast<std::uintptr_t>(y);
+    return a + n <= b || b + n <= a;
+  }
+
+  inline void copy_bytes_streaming(const char* f_i, std::size_t n, char* f_o)
+  {
+    // Precondition: [f_i, f_i + n) and [f_o, f_o + n) are disjoint
+#if defined(__SSE2__) || defined(_M_X64)
+    std::size_t h = (16 - reinterpret_cast<std::uintptr_t>(f_o) % 16) % 16;
+    if (h + 64 <= n) {
+      std::memcpy(f_o, f_i, h);
+      f_i = f_i + h;
+      f_o = f_o + h;
+      n = n - h;
+      while (n >= 64) {
+        const __m128i* x = reinterpret_cast<const __m128i*>(f_i);
+        __m128i* y = reinterpret_cast<__m128i*>(f_o);
+        __m128i x0 = _mm_loadu_si128(x);
+        __m128i x1 = _mm_loadu_si128(x + 1);
+        __m128i x2 = _mm_loadu_si128(x + 2);
+        __m128i x3 = _mm_loadu_si128(x + 3);
+        _mm_stream_si128(y, x0);
+        _mm_stream_si128(y + 1, x1);
+        _mm_stream_si128(y + 2, x2);
+        _mm_stream_si128(y + 3, x3);
+        f_i = f_i + 64;
+        f_o = f_o + 64;
+        n = n - 64;
+      }
+      _mm_sfence();
+    }
+#endif
+    std::memcpy(f_o, f_i, n);
+  }
+
+  inline void copy_backward_bytes_streaming(const char* l_i, std::size_t n, char* l_o)
+  {
+    // Precondition: [l_i - n, l_i) and [l_o - n, l_o) are disjoint
+#if defined(__SSE2__) || defined(_M_X64)
+    std::size_t h = reinterpret_cast<std::uintptr_t>(l_o) % 16;
+    if (h + 64 <= n) {
+      l_i = l_i - h;
+      l_o = l_o - h;
+      std::memcpy(l_o, l_i, h);
+      n = n - h;
+      while (n >= 64) {
+        l_i = l_i - 64;
+        l_o = l_o - 64;
+        const __m128i* x = reinterpret_cast<const __m128i*>(l_i);
+        __m128i* y = reinterpret_cast<__m128i*>(l_o);
+        __m128i x3 = _mm_loadu_si128(x + 3);
+        __m128i x2 = _mm_loadu_si128(x + 2);
+        __m128i x1 = _mm_loadu_si128(x + 1);
+        __m128i x0 = _mm_loadu_si128(x);
+        _mm_stream_si128(y + 3, x3);
+        _mm_stream_si128(y + 2, x2);
+        _mm_stream_si128(y + 1, x1);
+        _mm_stream_si128(y, x0);
+        n = n - 64;
+      }
+      _mm_sfence();
+    }
+#endif
+    std::memcpy(l_o - n, l_i - n, n);
+  }
+
+  template<typename T0, typename T1, typename N>
+    requires(Integer(N))
+  std::pair<pointer(T0), pointer(T1)>
+  copy_n_contiguous(pointer(T0) f_i, N n, pointer(T1) f_o, std::true_type)
+  {
+    // Precondition: non_overlapped_forward(fi, fi+n, fo, fo+n)
+    if (!zero(n)) std::memmove(f_o, f_i, std::size_t(n) * sizeof(T1));
+    return std::make_pair(f_i + n, f_o + n);
+  }
+
+  template<typename T0, typename T1, typename N>
+    requires(Integer(N))
+  std::pair<pointer(T0), pointer(T1)>
+  copy_n_contiguous(pointer(T0) f_i, N n, pointer(T1) f_o, std::false_type)
+  {
+    // Precondition: non_overlapped_forward(fi, fi+n, fo, fo+n)
+    while(count_down(n)) copy_step(f_i, f_o);
+    return std::make_pair(f_i, f_o);
+  }
+
+  template<typename T0, typename T1, typename N>
+    requires(Integer(N))
+  std::pair<pointer(T0), pointer(T1)> copy_n(pointer(T0) f_i, N n, pointer(T1) f_o)
+  {
+    // Precondition: non_overlapped_forward(fi, fi+n, fo, fo+n)
+    return copy_n_contiguous(f_i, n, f_o, contiguous_copyable<T0, T1>());
+  }
+
+  template<typename T0, typename T1>
+  std::pair<pointer(T0), pointer(T1)>
+  copy_bounded(pointer(T0) f_i, pointer(T0) l_i, pointer(T1) f_o, pointer(T1) l_o)
+  {
+    // Precondition: not_overlapped_forward(fi, li, fo, lo)
+    if (l_o - f_o < l_i - f_i) return copy_n(f_i, l_o - f_o, f_o);
+    return copy_n(f_i, l_i - f_i, f_o);
+  }
+
+  template<typename T0, typename T1, typename N>
+    requires(Integer(N))
+  std::pair<pointer(T0), pointer(T1)>
+  copy_backward_n_contiguous(pointer(T0) l_i, N n, pointer(T1) l_o, std::true_type)
+  {
+    // Precondition: not_overlapped_backward(li - n, li, lo - n, lo)
+    if (!zero(n)) std::memmove(l_o - n, l_i - n, std::size_t(n) * sizeof(T1));
+    return std::make_pair(l_i - n, l_o - n);
+  }
+
+  template<typename T0, typename T1, typename N>
+    requires(Integer(N))
+  std::pair<pointer(T0), pointer(T1)>
+  copy_backward_n_contiguous(pointer(T0) l_i, N n, pointer(T1) l_o, std::false_type)
+  {
+    // Precondition: not_overlapped_backward(li - n, li, lo - n, lo)
+    while(count_down(n)) copy_backward_step(l_i, l_o);
+    return std::make_pair(l_i, l_o);
+  }
+
+  template<typename T0, typename T1, typename N>
+    requires(Integer(N))
+  std::pair<pointer(T0), pointer(T1)> copy_backward_n(pointer(T0) l_i, N n, pointer(T1) l_o)
+  {
+    // Precondition: not_overlapped_backward(li - n, li, lo - n, lo)
+    return copy_backward_n_contiguous(l_i, n, l_o, contiguous_copyable<T0, T1>());
+  }
+
+  template<typename T0, typename T1, typename N>
+    requires(Integer(N))
+  std::pair<pointer(T0), pointer(T1)> copy_n_streaming(pointer(T0) f_i, N n, pointer(T1) f_o)
+  {
+    // Precondition: non_overlapped_forward(fi, fi+n, fo, fo+n)
+    static_assert(contiguous_copyable<T0, T1>::value, "copy_n_streaming copies bytes");
+    std::size_t b = std::size_t(n) * sizeof(T1);
+    if (b < streaming_copy_threshold_bytes || !disjoint_bytes(f_i, f_o, b))
+      return copy_n(f_i, n, f_o);
+    copy_bytes_streaming(reinterpret_cast<const char*>(f_i), b, reinterpret_cast<char*>(f_o));
+    return std::make_pair(f_i + n, f_o + n);
+  }
+
+  template<typename T0, typename T1, typename N>
+    requires(Integer(N))
+  std::pair<pointer(T0), pointer(T1)> copy_backward_n_streaming(pointer(T0) l_i, N n, pointer(T1) l_o)
+  {
+    // Precondition: not_overlapped_backward(li - n, li, lo - n, lo)
+    static_assert(contiguous_copyable<T0, T1>::value, "copy_backward_n_streaming copies bytes");
+    std::size_t b = std::size_t(n) * sizeof(T1);
+    if (b < streaming_copy_threshold_bytes || !disjoint_bytes(l_i - n, l_o - n, b))
+      return copy_backward_n(l_i, n, l_o);
+    copy_backward_bytes_streaming(reinterpret_cast<const char*>(l_i), b, reinterpret_cast<char*>(l_o));
+    return std::make_pair(l_i - n, l_o - n);
+  }
+
   template<typename I, typename O>
     requires(Readable(I) && BidirectionalIterator(I) &&
 	     Readable(O) && Iterator(O) &&
@@ -2891,19 +4011,281 @@ namespace eop {
     return split_copy_n(f_i, n_i, f_f, f_t, ps);
   }
 
-  template<typename I0, typename I1,  typename O, typename R>
-    requires(Readable(I0) && Iterator(I0) &&
-       Readable(I1) && Iterator(I1) &&
-       Writable(O) && Iterator(O) &&
-       BinaryPredicate(R) &&
-       ValueType(I0) == ValueType(0) &&
-       ValueType(I1) == ValueType(0) &&
-       IO == InputType(R, 1) && I1 == InputType(R, O))
-  O combine_copy(I0 f_i0, I0 l_i0, I1 f_i1, I1 l_i1, O f_o, R r)
-  {
-    // Precondition: (backward_offset(f_i0, l_i0, f_o, l_o, l_i1 - f_i1) && not_overlapped(f_i1, l_i1, f_o, l_o) ||
-    //                backward_offset(f_i1, l_i1, f_o, l_o, l_i0 - f_i0) && not_overlapped(f_i0, l_i0, f_o, l_o) )
-    while(f_i0 != l_i0 && f_i1 != l_i1) {
+  // Stream compaction of contiguous arithmetic ranges: the input is taken
+  // in blocks of compaction_block_size elements. The predicate is applied
+  // to each element of a block and the element is stored at the end of a
+  // buffer unconditionally, advancing the end by the result, so the loop
+  // has no branch on the predicate; the selected elements are then copied
+  // out with one memmove. With SSSE3 elements of 4 or 8 bytes are
+  // compacted a register at a time: the results of the predicate form a
+  // mask, which indexes a table of byte shuffles moving the selected lanes
+  // to the front.
+  // Since a block is read entirely before it is written, the outputs may
+  // overlap the input as the preconditions of the generic versions allow.
+  // Without the shuffles the blocks lose to the generic loop when the
+  // predicate almost always or almost never holds, since its branch is
+  // then predicted, so copy_select and split_copy_n take them only with
+  // SSSE3; copy_select_blocked and split_copy_n_blocked take them always.
+
+  const int compaction_block_size = 256;
+
+  template<typename T>
+    requires(Regular(T))
+  struct compaction_table
+  {
+    // The row of a mask of 16 / sizeof(T) lanes moves its lanes to the
+    // front of the register, count is the number of lanes in the mask
+    static const int lanes = 16 / sizeof(T);
+    alignas(16) unsigned char shuffle[1 << lanes][16];
+    int count[1 << lanes];
+    compaction_table()
+    {
+      for (int m = 0; m < (1 << lanes); m = successor(m)) {
+        int k = 0;
+        for (int i = 0; i < lanes; i = successor(i)) {
+          if ((m >> i) & 1) {
+            for (int j = 0; j < int(sizeof(T)); j = successor(j))
+              shuffle[m][k * int(sizeof(T)) + j] = (unsigned char)(i * int(sizeof(T)) + j);
+            k = successor(k);
+          }
+        }
+        for (int j = k * int(sizeof(T)); j < 16; j = successor(j)) shuffle[m][j] = 0x80;
+        count[m] = k;
+      }
+    }
+    static const compaction_table& instance()
+    {
+      static const compaction_table t;
+      return t;
+    }
+  };
+
+  template<typename T>
+    requires(Arithmetic(T))
+  struct compaction_by_shuffle :
+    std::integral_constant<bool,
+#if defined(__SSSE3__)
+      sizeof(T) == 4 || sizeof(T) == 8
+#else
+      false
+#endif
+    >
+  {
+  };
+
+#if defined(__SSSE3__)
+  template<typename T, typename P>
+    requires(Arithmetic(T) && UnaryPredicate(P) && pointer(T) == Domain(P))
+  unsigned compaction_mask(pointer(T) f, P& p)
+  {
+    // Postcondition: bit i of the result is p(f + i), for the lanes of a
+    // register
+    // Written out, since the loop over the lanes is not unrolled
+    unsigned m = unsigned(bool(p(f))) | unsigned(bool(p(f + 1))) << 1;
+    if (sizeof(T) == 4)
+      m = m | unsigned(bool(p(f + 2))) << 2 | unsigned(bool(p(f + 3))) << 3;
+    return m;
+  }
+
+  template<typename T0, typename T1, typename P>
+    requires(Arithmetic(T1) && UnaryPredicate(P) && pointer(T0) == Domain(P))
+  void select_registers(pointer(T0) f, int n, pointer(T1) b_t, P& p, int& i, int& k, std::true_type)
+  {
+    const compaction_table<T1>& t = compaction_table<T1>::instance();
+    const int lanes = compaction_table<T1>::lanes;
+    while (i + lanes <= n) {
+      unsigned m = compaction_mask(f + i, p);
+      __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f + i));
+      __m128i s = _mm_load_si128(reinterpret_cast<const __m128i*>(t.shuffle[m]));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(b_t + k), _mm_shuffle_epi8(x, s));
+      k = k + t.count[m];
+      i = i + lanes;
+    }
+  }
+
+  template<typename T0, typename T1, typename P>
+    requires(Arithmetic(T1) && UnaryPredicate(P) && pointer(T0) == Domain(P))
+  void split_registers(pointer(T0) f, int n, pointer(T1) b_f, pointer(T1) b_t, P& p,
+                       int& i, int& k, std::true_type)
+  {
+    const compaction_table<T1>& t = compaction_table<T1>::instance();
+    const int lanes = compaction_table<T1>::lanes;
+    const unsigned all = (1u << lanes) - 1u;
+    while (i + lanes <= n) {
+      unsigned m = compaction_mask(f + i, p);
+      __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f + i));
+      __m128i s_t = _mm_load_si128(reinterpret_cast<const __m128i*>(t.shuffle[m]));
+      __m128i s_f = _mm_load_si128(reinterpret_cast<const __m128i*>(t.shuffle[m ^ all]));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(b_t + k), _mm_shuffle_epi8(x, s_t));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(b_f + (i - k)), _mm_shuffle_epi8(x, s_f));
+      k = k + t.count[m];
+      i = i + lanes;
+    }
+  }
+#endif
+
+  template<typename T0, typename T1, typename P>
+  void select_registers(pointer(T0), int, pointer(T1), P&, int&, int&, std::false_type)
+  {
+  }
+
+  template<typename T0, typename T1, typename P>
+  void split_registers(pointer(T0), int, pointer(T1), pointer(T1), P&, int&, int&, std::false_type)
+  {
+  }
+
+  template<typename T0, typename T1, typename P>
+    requires(Arithmetic(T1) && UnaryPredicate(P) && pointer(T0) == Domain(P))
+  int select_block(pointer(T0) f, int n, pointer(T1) b_t, P& p)
+  {
+    // Precondition: 0 <= n <= compaction_block_size and b_t has room for
+    // compaction_block_size + 16 / sizeof(T1) elements
+    // Postcondition: returns the number of the elements satisfying p,
+    // stored in order at b_t
+    int i = 0;
+    int k = 0;
+    select_registers(f, n, b_t, p, i, k, compaction_by_shuffle<T1>());
+    while (i != n) {
+      b_t[k] = f[i];
+      k = k + int(bool(p(f + i)));
+      i = successor(i);
+    }
+    return k;
+  }
+
+  template<typename T0, typename T1, typename P>
+    requires(Arithmetic(T1) && UnaryPredicate(P) && pointer(T0) == Domain(P))
+  int split_block(pointer(T0) f, int n, pointer(T1) b_f, pointer(T1) b_t, P& p)
+  {
+    // Precondition: as for select_block, for both b_f and b_t
+    // Postcondition: returns the number of the elements satisfying p, stored
+    // in order at b_t; the others are stored in order at b_f
+    int i = 0;
+    int k = 0;
+    split_registers(f, n, b_f, b_t, p, i, k, compaction_by_shuffle<T1>());
+    while (i != n) {
+      T1 x = f[i];
+      b_t[k] = x;
+      b_f[i - k] = x;
+      k = k + int(bool(p(f + i)));
+      i = successor(i);
+    }
+    return k;
+  }
+
+  template<typename T0, typename T1, typename P>
+    requires(Arithmetic(T1) && UnaryPredicate(P) && pointer(T0) == Domain(P))
+  pointer(T1) copy_select_contiguous(pointer(T0) f_i, pointer(T0) l_i, pointer(T1) f_t, P p, std::true_type)
+  {
+    T1 b_t[compaction_block_size + 16 / sizeof(T1)];
+    while (f_i != l_i) {
+      int n = l_i - f_i < compaction_block_size ? int(l_i - f_i) : compaction_block_size;
+      int k = select_block(f_i, n, b_t, p);
+      f_t = copy_n(&b_t[0], k, f_t).second;
+      f_i = f_i + n;
+    }
+    return f_t;
+  }
+
+  template<typename T0, typename T1, typename P>
+    requires(UnaryPredicate(P) && pointer(T0) == Domain(P))
+  pointer(T1) copy_select_contiguous(pointer(T0) f_i, pointer(T0) l_i, pointer(T1) f_t, P p, std::false_type)
+  {
+    return eop::copy_select<pointer(T0), pointer(T1), P>(f_i, l_i, f_t, p);
+  }
+
+  template<typename T0, typename T1>
+  struct compaction_default :
+    std::integral_constant<bool,
+      contiguous_compactable<T0, T1>::value && compaction_by_shuffle<T1>::value>
+  {
+  };
+
+  template<typename T0, typename T1, typename P>
+    requires(UnaryPredicate(P) && pointer(T0) == Domain(P))
+  pointer(T1) copy_select(pointer(T0) f_i, pointer(T0) l_i, pointer(T1) f_t, P p)
+  {
+    // Precondtion: not_overlapped_forward(fi, li, f_t, f_t + nt)
+    // where nt is the upper bound for the nuumber of iterators satisfying p
+    return copy_select_contiguous(f_i, l_i, f_t, p, compaction_default<T0, T1>());
+  }
+
+  template<typename T0, typename T1, typename P>
+    requires(UnaryPredicate(P) && pointer(T0) == Domain(P))
+  pointer(T1) copy_select_blocked(pointer(T0) f_i, pointer(T0) l_i, pointer(T1) f_t, P p)
+  {
+    // Precondition: same as copy_select
+    return copy_select_contiguous(f_i, l_i, f_t, p, contiguous_compactable<T0, T1>());
+  }
+
+  template<typename T0, typename T1, typename P>
+    requires(Arithmetic(T1) && UnaryPredicate(P) && pointer(T0) == Domain(P))
+  std::pair<pointer(T1), pointer(T1)>
+  split_copy_n_contiguous(pointer(T0) f_i, DistanceType(pointer(T0)) n_i,
+                          pointer(T1) f_f, pointer(T1) f_t, P p, std::true_type)
+  {
+    T1 b_f[compaction_block_size + 16 / sizeof(T1)];
+    T1 b_t[compaction_block_size + 16 / sizeof(T1)];
+    while (!zero(n_i)) {
+      int n = n_i < compaction_block_size ? int(n_i) : compaction_block_size;
+      int k = split_block(f_i, n, &b_f[0], &b_t[0], p);
+      f_f = copy_n(&b_f[0], n - k, f_f).second;
+      f_t = copy_n(&b_t[0], k, f_t).second;
+      f_i = f_i + n;
+      n_i = n_i - n;
+    }
+    return std::pair<pointer(T1), pointer(T1)>(f_f, f_t);
+  }
+
+  template<typename T0, typename T1, typename P>
+    requires(UnaryPredicate(P) && pointer(T0) == Domain(P))
+  std::pair<pointer(T1), pointer(T1)>
+  split_copy_n_contiguous(pointer(T0) f_i, DistanceType(pointer(T0)) n_i,
+                          pointer(T1) f_f, pointer(T1) f_t, P p, std::false_type)
+  {
+    return eop::split_copy_n<pointer(T0), pointer(T1), pointer(T1), P>(f_i, n_i, f_f, f_t, p);
+  }
+
+  template<typename T0, typename T1, typename P>
+    requires(UnaryPredicate(P) && pointer(T0) == Domain(P))
+  std::pair<pointer(T1), pointer(T1)>
+  split_copy_n(pointer(T0) f_i, DistanceType(pointer(T0)) n_i, pointer(T1) f_f, pointer(T1) f_t, P p)
+  {
+    // Precondition: same as split_copy
+    return split_copy_n_contiguous(f_i, n_i, f_f, f_t, p, compaction_default<T0, T1>());
+  }
+
+  template<typename T0, typename T1, typename P>
+    requires(UnaryPredicate(P) && pointer(T0) == Domain(P))
+  std::pair<pointer(T1), pointer(T1)>
+  split_copy_n_blocked(pointer(T0) f_i, DistanceType(pointer(T0)) n_i, pointer(T1) f_f, pointer(T1) f_t, P p)
+  {
+    // Precondition: same as split_copy
+    return split_copy_n_contiguous(f_i, n_i, f_f, f_t, p, contiguous_compactable<T0, T1>());
+  }
+
+  template<typename T0, typename T1, typename P>
+    requires(UnaryPredicate(P) && pointer(T0) == Domain(P))
+  std::pair<pointer(T1), pointer(T1)>
+  split_copy(pointer(T0) f_i, pointer(T0) l_i, pointer(T1) f_f, pointer(T1) f_t, P p)
+  {
+    // Precondition: same as split_copy
+    return split_copy_n(f_i, DistanceType(pointer(T0))(l_i - f_i), f_f, f_t, p);
+  }
+
+  template<typename I0, typename I1,  typename O, typename R>
+    requires(Readable(I0) && Iterator(I0) &&
+       Readable(I1) && Iterator(I1) &&
+       Writable(O) && Iterator(O) &&
+       BinaryPredicate(R) &&
+       ValueType(I0) == ValueType(0) &&
+       ValueType(I1) == ValueType(0) &&
+       IO == InputType(R, 1) && I1 == InputType(R, O))
+  O combine_copy(I0 f_i0, I0 l_i0, I1 f_i1, I1 l_i1, O f_o, R r)
+  {
+    // Precondition: (backward_offset(f_i0, l_i0, f_o, l_o, l_i1 - f_i1) && not_overlapped(f_i1, l_i1, f_o, l_o) ||
+    //                backward_offset(f_i1, l_i1, f_o, l_o, l_i0 - f_i0) && not_overlapped(f_i0, l_i0, f_o, l_o) )
+    while(f_i0 != l_i0 && f_i1 != l_i1) {
       if (r(f_i1, f_i0)) copy_step(f_i1, f_o);
       else               copy_step(f_i0, f_o);
     }
@@ -2944,7 +4326,7 @@ namespace eop {
       // Precondition: in addition to that for combine_copy
       //   weak_ordering(r) &&
       //   increasing_order(f_i0, l_i0, r) && increasing_order(f_i1, l_i1, r)
-      relation_source<I0, I1, R> rs(r);
+      relation_source<I1, I0, R> rs(r);
       return combine_copy(f_i0, l_i0, f_i1, l_i1, f_o, rs);
   }
 
@@ -2961,7 +4343,7 @@ namespace eop {
       // Precondition: in addition to that for combine_copy_backward
       //  weak_ordering(r) &&
       //  increasing_order(f_i0, l_i0, r) && increasing_order(f_i1, l_i1, r)
-      relation_source<I0, I1, R> rs(r);
+      relation_source<I1, I0, R> rs(r);
       return combine_copy_backward(f_i0, l_i0, f_i1, l_i0, f_o, rs);
   }
 
@@ -2978,8 +4360,8 @@ namespace eop {
     while(!zero(n_0) && !zero(n_1))
       if (r(f_i1, f_i0)) { copy_step(f_i1, f_o); n_1 = predecessor(n_1); }
       else               { copy_step(f_i0, f_o); n_0 = predecessor(n_0); }
-    std::pair<I1, O> l1 = copy_n(f_i1, n_1, f_o);
-    std::pair<I0, O> l0 = copy_n(f_i0, n_0, l1.second);
+    std::pair<I1, O> l1 = eop::copy_n(f_i1, n_1, f_o);
+    std::pair<I0, O> l0 = eop::copy_n(f_i0, n_0, l1.second);
     return std::tuple<I0, I1, O>(l0.first, l1.first, l0.second);
   }
 
@@ -2994,7 +4376,7 @@ namespace eop {
     std::tuple<InputIterator0, InputIterator1, OutputIterator> merge_copy_n(
                 InputIterator0 f_i0, Num n_0, InputIterator1 f_i1, Num n_1, OutputIterator f_o, Relation r)
   {
-    relation_source<InputIterator0, InputIterator1, Relation> rs(r);
+    relation_source<InputIterator1, InputIterator0, Relation> rs(r);
     return combine_copy_n(f_i0, n_0, f_i1, n_1, f_o, rs);
   }
 
@@ -3023,10 +4405,382 @@ namespace eop {
   template<typename N, typename I0, typename I1, typename O, typename R>
   std::tuple<I0, I1, O> merge_copy_backward_n(I0 f_i0, N n0, I1 f_i1, N n1, O l_o, R r)
   {
-    relation_source<I0, I1, R> rs(r);
+    relation_source<I1, I0, R> rs(r);
     return combine_copy_backward_n(f_i0, n0, f_i1, n1, l_o, rs);
   }
 
+  // Branchless merging of contiguous arithmetic ranges: which range the
+  // next element comes from is not predictable when the ranges interleave,
+  // so the element is chosen by indexing a pair of the two heads with the
+  // result of the relation, and the two iterators advance by it and by its
+  // complement. The heads are both read before the output is written, so
+  // the output may overlap the inputs as combine_copy allows.
+  // Every step costs the same, so the kernel loses to the branch of
+  // combine_copy once the ranges alternate in runs the branch predicts; it
+  // is called explicitly, as merge_copy_n_branchless, rather than taken by
+  // merge_copy_n for every arithmetic range.
+
+  template<typename T0, typename T1, typename T2>
+  struct branchless_mergeable :
+    std::integral_constant<bool,
+      std::is_same<typename std::remove_const<T0>::type, T2>::value &&
+      std::is_same<typename std::remove_const<T1>::type, T2>::value &&
+      std::is_arithmetic<T2>::value>
+  {
+  };
+
+  template<typename T0, typename T1, typename T2, typename R>
+    requires(Arithmetic(T2) && BinaryPredicate(R) &&
+             pointer(T0) == InputType(R, 1) && pointer(T1) == InputType(R, 0))
+  void combine_copy_branchless(pointer(T0)& f_i0, pointer(T0) l_i0,
+                               pointer(T1)& f_i1, pointer(T1) l_i1,
+                               pointer(T2)& f_o, R& r)
+  {
+    // Precondition: as for combine_copy
+    // Postcondition: one of the ranges is empty, and the elements taken
+    // from them are combined before f_o
+    while (true) {
+      // n steps cannot exhaust either range before the last one
+      DistanceType(pointer(T0)) n = l_i0 - f_i0 < l_i1 - f_i1 ? l_i0 - f_i0 : l_i1 - f_i1;
+      if (zero(n)) return;
+      while (count_down(n)) {
+        bool b = r(f_i1, f_i0);
+        T2 x0 = source(f_i0);
+        T2 x1 = source(f_i1);
+        sink(f_o) = b ? x1 : x0;
+        f_o = successor(f_o);
+        f_i0 = f_i0 + int(!b);
+        f_i1 = f_i1 + int(b);
+      }
+    }
+  }
+
+  template<typename T0, typename T1, typename T2, typename R>
+    requires(Arithmetic(T2) && BinaryPredicate(R) &&
+             pointer(T0) == InputType(R, 1) && pointer(T1) == InputType(R, 0))
+  void combine_copy_branchless_bidirectional(pointer(T0)& f_i0, pointer(T0)& l_i0,
+                                             pointer(T1)& f_i1, pointer(T1)& l_i1,
+                                             pointer(T2)& f_o, pointer(T2)& l_o, R& r)
+  {
+    // Precondition: as for combine_copy, and the output does not overlap
+    // the inputs; l_o == f_o + (l_i0 - f_i0) + (l_i1 - f_i1)
+    // Postcondition: the ranges have been shortened at both ends, their
+    // elements combined before f_o and from l_o on, and one of them has
+    // fewer than two elements left
+    // Each step takes the least element at the front and the greatest at
+    // the back; the two are independent, so the latencies of the loads
+    // that decide them overlap
+    while (true) {
+      // n steps take at most 2n elements from either range
+      DistanceType(pointer(T0)) n = l_i0 - f_i0 < l_i1 - f_i1 ? l_i0 - f_i0 : l_i1 - f_i1;
+      n = half_nonnegative(n);
+      if (zero(n)) return;
+      while (count_down(n)) {
+        bool b = r(f_i1, f_i0);
+        T2 x0 = source(f_i0);
+        T2 x1 = source(f_i1);
+        sink(f_o) = b ? x1 : x0;
+        f_o = successor(f_o);
+        f_i0 = f_i0 + int(!b);
+        f_i1 = f_i1 + int(b);
+        // The last element of range 1 is the greater unless it precedes
+        // the last of range 0
+        bool c = r(predecessor(l_i1), predecessor(l_i0));
+        T2 y0 = source(predecessor(l_i0));
+        T2 y1 = source(predecessor(l_i1));
+        l_o = predecessor(l_o);
+        sink(l_o) = c ? y0 : y1;
+        l_i0 = l_i0 - int(c);
+        l_i1 = l_i1 - int(!c);
+      }
+    }
+  }
+
+  template<typename T0, typename T1, typename T2, typename R>
+    requires(BinaryPredicate(R) &&
+             pointer(T0) == InputType(R, 1) && pointer(T1) == InputType(R, 0))
+  pointer(T2) combine_copy_contiguous(pointer(T0) f_i0, pointer(T0) l_i0,
+                                      pointer(T1) f_i1, pointer(T1) l_i1,
+                                      pointer(T2) f_o, R r, std::true_type)
+  {
+    pointer(T2) l_o = f_o + (l_i0 - f_i0) + (l_i1 - f_i1);
+    pointer(T2) m_o = l_o;
+    if (disjoint_bytes(f_i0, f_o, sizeof(T2) * std::size_t(m_o - f_o)) &&
+        disjoint_bytes(f_i1, f_o, sizeof(T2) * std::size_t(m_o - f_o)))
+      combine_copy_branchless_bidirectional(f_i0, l_i0, f_i1, l_i1, f_o, m_o, r);
+    combine_copy_branchless(f_i0, l_i0, f_i1, l_i1, f_o, r);
+    eop::copy(f_i1, l_i1, eop::copy(f_i0, l_i0, f_o));
+    return l_o;
+  }
+
+  template<typename T0, typename T1, typename T2, typename R>
+    requires(BinaryPredicate(R) &&
+             pointer(T0) == InputType(R, 1) && pointer(T1) == InputType(R, 0))
+  pointer(T2) combine_copy_contiguous(pointer(T0) f_i0, pointer(T0) l_i0,
+                                      pointer(T1) f_i1, pointer(T1) l_i1,
+                                      pointer(T2) f_o, R r, std::false_type)
+  {
+    return eop::combine_copy<pointer(T0), pointer(T1), pointer(T2), R>(f_i0, l_i0, f_i1, l_i1, f_o, r);
+  }
+
+  template<typename N, typename T0, typename T1, typename T2, typename R>
+    requires(Integer(N) && BinaryPredicate(R) &&
+             pointer(T0) == InputType(R, 1) && pointer(T1) == InputType(R, 0))
+  std::tuple<pointer(T0), pointer(T1), pointer(T2)>
+  combine_copy_n_contiguous(pointer(T0) f_i0, N n_0, pointer(T1) f_i1, N n_1,
+                            pointer(T2) f_o, R r, std::true_type)
+  {
+    pointer(T0) l_i0 = f_i0 + n_0;
+    pointer(T1) l_i1 = f_i1 + n_1;
+    pointer(T2) l_o = combine_copy_contiguous(f_i0, l_i0, f_i1, l_i1, f_o, r, std::true_type());
+    return std::tuple<pointer(T0), pointer(T1), pointer(T2)>(l_i0, l_i1, l_o);
+  }
+
+  template<typename N, typename T0, typename T1, typename T2, typename R>
+    requires(Integer(N) && BinaryPredicate(R) &&
+             pointer(T0) == InputType(R, 1) && pointer(T1) == InputType(R, 0))
+  std::tuple<pointer(T0), pointer(T1), pointer(T2)>
+  combine_copy_n_contiguous(pointer(T0) f_i0, N n_0, pointer(T1) f_i1, N n_1,
+                            pointer(T2) f_o, R r, std::false_type)
+  {
+    return eop::combine_copy_n<N, pointer(T0), pointer(T1), pointer(T2), R>(f_i0, n_0, f_i1, n_1, f_o, r);
+  }
+
+  template<typename N, typename T0, typename T1, typename T2, typename R>
+    requires(Integer(N) && Relation(R) && T2 == Domain(R))
+  std::tuple<pointer(T0), pointer(T1), pointer(T2)>
+  merge_copy_n_branchless(pointer(T0) f_i0, N n_0, pointer(T1) f_i1, N n_1, pointer(T2) f_o, R r)
+  {
+    // Precondition: as for merge_copy_n
+    // Ranges of other than one arithmetic type are merged by merge_copy_n
+    relation_source<pointer(T1), pointer(T0), R> rs(r);
+    return combine_copy_n_contiguous(f_i0, n_0, f_i1, n_1, f_o, rs, branchless_mergeable<T0, T1, T2>());
+  }
+
+#if defined(__SSE2__) || defined(_M_X64)
+  // Bitonic merging of increasing ranges of 32-bit integers under their
+  // natural order, four lanes at a time (Inoue et al.): the network merges
+  // the four greatest elements taken so far with the next four of the range
+  // whose next element is smaller, and the four smallest results are final.
+  // The network does not keep equal elements in order, which cannot be
+  // observed for integers.
+
+  inline __m128i min_epi32(__m128i x, __m128i y)
+  {
+#if defined(__SSE4_1__)
+    return _mm_min_epi32(x, y);
+#else
+    __m128i g = _mm_cmpgt_epi32(x, y);
+    return _mm_or_si128(_mm_and_si128(g, y), _mm_andnot_si128(g, x));
+#endif
+  }
+
+  inline __m128i max_epi32(__m128i x, __m128i y)
+  {
+#if defined(__SSE4_1__)
+    return _mm_max_epi32(x, y);
+#else
+    __m128i g = _mm_cmpgt_epi32(x, y);
+    return _mm_or_si128(_mm_and_si128(g, x), _mm_andnot_si128(g, y));
+#endif
+  }
+
+  inline void bitonic_merge_4(__m128i& x, __m128i& y)
+  {
+    // Precondition: the lanes of x and of y are increasing
+    // Postcondition: x holds the four smallest of the eight lanes and y
+    // the four greatest, each increasing
+    y = _mm_shuffle_epi32(y, _MM_SHUFFLE(0, 1, 2, 3));
+    __m128i l = min_epi32(x, y);
+    __m128i h = max_epi32(x, y);
+    // l and h are bitonic; compare the lanes 2 apart, then 1 apart
+    __m128i l0 = _mm_unpacklo_epi64(l, h);
+    __m128i h0 = _mm_unpackhi_epi64(l, h);
+    l = min_epi32(l0, h0);
+    h = max_epi32(l0, h0);
+    __m128i u = _mm_unpacklo_epi32(l, h);
+    __m128i v = _mm_unpackhi_epi32(l, h);
+    __m128i l1 = _mm_unpacklo_epi64(u, v);
+    __m128i h1 = _mm_unpackhi_epi64(u, v);
+    l = min_epi32(l1, h1);
+    h = max_epi32(l1, h1);
+    x = _mm_unpacklo_epi32(l, h);
+    y = _mm_unpackhi_epi32(l, h);
+  }
+
+  inline std::tuple<const int*, const int*, int*>
+  merge_copy_n_bitonic(const int* f_i0, int n_0, const int* f_i1, int n_1, int* f_o)
+  {
+    // Precondition: as for merge_copy_n with less<int>
+    // Postcondition: as for merge_copy_n
+    const int* l_i0 = f_i0 + n_0;
+    const int* l_i1 = f_i1 + n_1;
+    eop::less<int> lt;
+    if (n_0 < 4 || n_1 < 4)
+      return merge_copy_n(f_i0, n_0, f_i1, n_1, f_o, lt);
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f_i0));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f_i1));
+    f_i0 = f_i0 + 4;
+    f_i1 = f_i1 + 4;
+    while (true) {
+      bitonic_merge_4(x, y);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(f_o), x);
+      f_o = f_o + 4;
+      if (l_i0 - f_i0 < 4 || l_i1 - f_i1 < 4) break;
+      int b = int(source(f_i1) < source(f_i0));
+      const int* h[2] = { f_i0, f_i1 };
+      x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h[b]));
+      f_i0 = f_i0 + 4 * (1 - b);
+      f_i1 = f_i1 + 4 * b;
+    }
+    // The four elements of y precede the rest of both ranges, and one of
+    // the ranges has fewer than four elements left: merge those two into a
+    // buffer, then the buffer with the other range
+    int y_b[4];
+    int b[8];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(y_b), y);
+    if (l_i0 - f_i0 < 4) {
+      int* l_b = merge_copy(&y_b[0], &y_b[0] + 4, f_i0, l_i0, &b[0], lt);
+      f_o = std::get<2>(merge_copy_n(&b[0], int(l_b - b), f_i1, int(l_i1 - f_i1), f_o, lt));
+    } else {
+      int* l_b = merge_copy(&y_b[0], &y_b[0] + 4, f_i1, l_i1, &b[0], lt);
+      f_o = std::get<2>(merge_copy_n(f_i0, int(l_i0 - f_i0), &b[0], int(l_b - b), f_o, lt));
+    }
+    return std::tuple<const int*, const int*, int*>(l_i0, l_i1, f_o);
+  }
+#endif
+
+  // Merging k ranges
+
+  // merge_copy_k merges k increasing ranges through a loser tree. The
+  // ranges are the leaves of a complete binary tree; each internal node
+  // holds the range that lost the match between the winners of its
+  // subtrees. Taking the first element of the winner replays only the
+  // matches on the path from its leaf to the root, so each element costs
+  // about log2 k comparisons and is copied once, where repeated pairwise
+  // merge_copy_n copies every element log2 k times. A node holds the index
+  // of its range and its head: a copy of the first element for small
+  // trivially copyable types, so a match reads one node, and otherwise an
+  // iterator to it.
+  //
+  // Equivalent elements are taken in the order of their ranges: the range
+  // with the smaller index wins a tie, which needs no extra comparison. An
+  // exhausted range gets index k plus its own and the greatest last element
+  // of the ranges as its head, so it loses every match without a test.
+
+  template<typename I, bool by_value>
+    requires(Readable(I) && Iterator(I))
+  struct loser_tree_head
+  {
+    typedef I type;
+    static I make(I i) { return i; }
+    static decltype(source(std::declval<I>())) value(const I& i) { return source(i); }
+  };
+
+  template<typename I>
+    requires(Readable(I) && Iterator(I))
+  struct loser_tree_head<I, true>
+  {
+    typedef typename std::decay<decltype(source(std::declval<I>()))>::type type;
+    static type make(I i) { return source(i); }
+    static const type& value(const type& x) { return x; }
+  };
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  bool loser_tree_beats(const T& x, int i, const T& y, int j, R& r)
+  {
+    // Postcondition: returns whether the range i with first element x beats
+    // the range j with first element y
+    // Both comparisons are made so the result is computed without branching
+    bool lt = r(x, y);
+    bool le = !r(y, x);
+    return lt | (le & (i < j));
+  }
+
+  template<typename H, typename K, typename R>
+    requires(Relation(R))
+  int loser_tree_build(int x, std::vector<K>& heads, std::vector<int>& indices, R& r)
+  {
+    // Precondition: 0 < x < 2 k, where the leaves are at [k, 2 k) in heads
+    // and indices
+    // Postcondition: returns the leaf at which the winner of the subtree at
+    // x is, after copying the losers of its matches to its internal nodes
+    int k = int(heads.size()) / 2;
+    if (k <= x) return x;
+    int a = loser_tree_build<H>(2 * x, heads, indices, r);
+    int b = loser_tree_build<H>(2 * x + 1, heads, indices, r);
+    if (loser_tree_beats(H::value(heads[a]), indices[a], H::value(heads[b]), indices[b], r)) std::swap(a, b);
+    heads[x] = heads[a];
+    indices[x] = indices[a];
+    return b;
+  }
+
+  template<typename S, typename O, typename R>
+    requires(Readable(S) && Iterator(S) &&
+      Writable(O) && Iterator(O) && Relation(R))
+  O merge_copy_k(S f_s, S l_s, O f_o, R r)
+  {
+    // Precondition: each source(s) for s in [f_s, l_s) is a pair of
+    // bidirectional iterators bounding an increasing range under r
+    // Precondition: weak_ordering(r) && the output does not overlap the ranges
+    // Postcondition: returns the end of the merged output, in which
+    // equivalent elements are in the order of their ranges
+    typedef typename std::decay<decltype(source(f_s).first)>::type I;
+    typedef typename std::decay<decltype(source(source(f_s).first))>::type T;
+    typedef loser_tree_head<I, std::is_trivially_copyable<T>::value && sizeof(T) <= 2 * sizeof(void*)> H;
+    typedef typename H::type K;
+    std::vector<std::pair<I, I>> ranges;
+    while (f_s != l_s) {
+      ranges.push_back(std::pair<I, I>(source(f_s).first, source(f_s).second));
+      f_s = successor(f_s);
+    }
+    int k = int(ranges.size());
+    int m = 0;
+    while (m != k && ranges[m].first == ranges[m].second) ++m;
+    if (m == k) return f_o;
+    I top = predecessor(ranges[m].second);
+    for (int i = m + 1; i < k; ++i) {
+      if (ranges[i].first != ranges[i].second && r(source(top), source(predecessor(ranges[i].second))))
+        top = predecessor(ranges[i].second);
+    }
+    std::vector<K> heads(2 * k, H::make(top));
+    std::vector<int> indices(2 * k);
+    for (int i = 0; i < k; ++i) {
+      if (ranges[i].first == ranges[i].second) indices[k + i] = k + i;
+      else {
+        heads[k + i] = H::make(ranges[i].first);
+        indices[k + i] = i;
+      }
+    }
+    int x = loser_tree_build<H>(1, heads, indices, r);
+    K w = heads[x];
+    int i = indices[x];
+    while (i < k) {
+      std::pair<I, I>& range = ranges[i];
+      copy_step(range.first, f_o);
+      x = (i + k) / 2;
+      if (range.first == range.second) {
+        w = H::make(top);
+        i = k + i;
+      }
+      else w = H::make(range.first);
+      // The matches are unpredictable, so the winner and the loser are
+      // selected by indexing rather than by branching
+      while (x != 0) {
+        K h[2] = { w, heads[x] };
+        int j[2] = { i, indices[x] };
+        int b = int(loser_tree_beats(H::value(h[1]), j[1], H::value(w), i, r));
+        heads[x] = h[1 - b];
+        indices[x] = j[1 - b];
+        w = h[b];
+        i = j[b];
+        x = x / 2;
+      }
+    }
+    return f_o;
+  }
+
 /*
  * Project 9.1 Modern computing systems include highly optimized library
  * procedures for copying memory; for example, memmove and memcpy, which use
@@ -3045,7 +4799,7 @@ namespace eop {
 	     ValueType(I0) == ValueType(I1))
   void exchange_values(I0 x, I1 y) {
     // Precondition: deref(x) and deref(y) are defined
-    ValueType(I0) t = source(x);
+    typename std::decay<decltype(source(x))>::type t = source(x);
             sink(x) = source(y);
             sink(y) = t;
     // Postcondition: x's and y's values has been exchanged
@@ -3150,6 +4904,246 @@ namespace eop {
     return std::make_pair(l0, f1);
   }
 
+  // Reverse swapping of contiguous ranges
+
+  // For pointers to trivially copyable types of 1 or 4 bytes
+  // reverse_swap_ranges_n loads a vector register from each end, mirrors the
+  // lanes and stores them crosswise. Elements as large as
+  // reverse_block_bytes are swapped a word at a time instead of through a
+  // temporary; the other sizes already move a register at a time.
+
+  const int reverse_block_bytes = 256;
+
+  inline std::uint64_t byte_swap(std::uint64_t x)
+  {
+#if defined(__GNUC__)
+    return __builtin_bswap64(x);
+#elif defined(_MSC_VER)
+    return _byteswap_uint64(x);
+#else
+    x = ((x & 0x00ff00ff00ff00ffull) << 8) | ((x >> 8) & 0x00ff00ff00ff00ffull);
+    x = ((x & 0x0000ffff0000ffffull) << 16) | ((x >> 16) & 0x0000ffff0000ffffull);
+    return (x << 32) | (x >> 32);
+#endif
+  }
+
+  inline void swap_bytes(char* x, char* y, std::size_t n)
+  {
+    // Precondition: [x, x + n) and [y, y + n) are disjoint
+    while (n >= 8) {
+      std::uint64_t a;
+      std::uint64_t b;
+      std::memcpy(&a, x, 8);
+      std::memcpy(&b, y, 8);
+      std::memcpy(x, &b, 8);
+      std::memcpy(y, &a, 8);
+      x = x + 8;
+      y = y + 8;
+      n = n - 8;
+    }
+    while (n != 0) {
+      char a = *x;
+      *x = *y;
+      *y = a;
+      x = x + 1;
+      y = y + 1;
+      n = n - 1;
+    }
+  }
+
+  template<int S>
+  std::size_t reverse_swap_lanes(char*&, char*&, std::size_t n)
+  {
+    // Precondition: [l0 - n * S, l0) and [f1, f1 + n * S) are disjoint
+    // Postcondition: returns the number of elements of size S left to swap;
+    // sizes without a lane shuffle swap none and leave l0 and f1 alone
+    return n;
+  }
+
+  template<>
+  inline std::size_t reverse_swap_lanes<1>(char*& l0, char*& f1, std::size_t n)
+  {
+#if defined(__SSSE3__)
+    const __m128i mirror = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                        8, 9, 10, 11, 12, 13, 14, 15);
+    while (n >= 16) {
+      l0 = l0 - 16;
+      __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l0));
+      __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f1));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(l0), _mm_shuffle_epi8(y, mirror));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(f1), _mm_shuffle_epi8(x, mirror));
+      f1 = f1 + 16;
+      n = n - 16;
+    }
+#endif
+    while (n >= 8) {
+      l0 = l0 - 8;
+      std::uint64_t x;
+      std::uint64_t y;
+      std::memcpy(&x, l0, 8);
+      std::memcpy(&y, f1, 8);
+      x = byte_swap(x);
+      y = byte_swap(y);
+      std::memcpy(l0, &y, 8);
+      std::memcpy(f1, &x, 8);
+      f1 = f1 + 8;
+      n = n - 8;
+    }
+    return n;
+  }
+
+#if defined(__SSE2__) || defined(_M_X64)
+  template<>
+  inline std::size_t reverse_swap_lanes<4>(char*& l0, char*& f1, std::size_t n)
+  {
+    while (n >= 4) {
+      l0 = l0 - 16;
+      __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l0));
+      __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f1));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(l0),
+                       _mm_shuffle_epi32(y, _MM_SHUFFLE(0, 1, 2, 3)));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(f1),
+                       _mm_shuffle_epi32(x, _MM_SHUFFLE(0, 1, 2, 3)));
+      f1 = f1 + 16;
+      n = n - 4;
+    }
+    return n;
+  }
+#endif
+
+  template<typename T, typename N>
+    requires(Integer(N))
+  std::pair<pointer(T), pointer(T)>
+  reverse_swap_ranges_n_contiguous(pointer(T) l0, pointer(T) f1, N n, std::true_type)
+  {
+    // Precondition: mutable_counted_range(l0 - n, n)
+    // Precondition: mutable_counted_range(f1, n)
+    // Precondition: the two ranges are disjoint
+    if (reverse_block_bytes <= sizeof(T)) {
+      while (count_down(n)) {
+        l0 = predecessor(l0);
+        swap_bytes(reinterpret_cast<char*>(l0), reinterpret_cast<char*>(f1), sizeof(T));
+        f1 = successor(f1);
+      }
+      return std::make_pair(l0, f1);
+    }
+    char* l0_c = reinterpret_cast<char*>(l0);
+    char* f1_c = reinterpret_cast<char*>(f1);
+    std::size_t m = reverse_swap_lanes<sizeof(T)>(l0_c, f1_c, std::size_t(n));
+    l0 = reinterpret_cast<pointer(T)>(l0_c);
+    f1 = reinterpret_cast<pointer(T)>(f1_c);
+    n = N(m);
+    while (count_down(n)) reverse_swap_step(l0, f1);
+    return std::make_pair(l0, f1);
+  }
+
+  template<typename T, typename N>
+    requires(Integer(N))
+  std::pair<pointer(T), pointer(T)>
+  reverse_swap_ranges_n_contiguous(pointer(T) l0, pointer(T) f1, N n, std::false_type)
+  {
+    // Precondition: mutable_counted_range(l0 - n, n)
+    // Precondition: mutable_counted_range(f1, n)
+    while(count_down(n)) reverse_swap_step(l0, f1);
+    return std::make_pair(l0, f1);
+  }
+
+  template<typename T, typename N>
+    requires(Integer(N))
+  std::pair<pointer(T), pointer(T)> reverse_swap_ranges_n(pointer(T) l0, pointer(T) f1, N n)
+  {
+    // Precondition: mutable_counted_range(l0 - n, n)
+    // Precondition: mutable_counted_range(f1, n)
+    // Precondition: the two ranges are disjoint
+    return reverse_swap_ranges_n_contiguous(l0, f1, n, std::is_trivially_copyable<T>());
+  }
+
+  // Swapping contiguous ranges
+
+  // swap_ranges_n on pointers to trivially copyable types swaps a word at a
+  // time; swap_ranges_n_streaming writes large ranges with non-temporal
+  // stores like copy_n_streaming
+
+  inline void swap_bytes_streaming(char* x, char* y, std::size_t n)
+  {
+    // Precondition: [x, x + n) and [y, y + n) are disjoint
+#if defined(__SSE2__) || defined(_M_X64)
+    // Non-temporal stores need both destinations aligned alike
+    std::size_t h = (16 - reinterpret_cast<std::uintptr_t>(x) % 16) % 16;
+    if (reinterpret_cast<std::uintptr_t>(x) % 16 == reinterpret_cast<std::uintptr_t>(y) % 16 &&
+        h + 64 <= n) {
+      swap_bytes(x, y, h);
+      x = x + h;
+      y = y + h;
+      n = n - h;
+      while (n >= 32) {
+        __m128i* a = reinterpret_cast<__m128i*>(x);
+        __m128i* b = reinterpret_cast<__m128i*>(y);
+        __m128i a0 = _mm_load_si128(a);
+        __m128i a1 = _mm_load_si128(a + 1);
+        __m128i b0 = _mm_load_si128(b);
+        __m128i b1 = _mm_load_si128(b + 1);
+        _mm_stream_si128(a, b0);
+        _mm_stream_si128(a + 1, b1);
+        _mm_stream_si128(b, a0);
+        _mm_stream_si128(b + 1, a1);
+        x = x + 32;
+        y = y + 32;
+        n = n - 32;
+      }
+      _mm_sfence();
+    }
+#endif
+    swap_bytes(x, y, n);
+  }
+
+  template<typename T, typename N>
+    requires(Integer(N))
+  std::pair<pointer(T), pointer(T)>
+  swap_ranges_n_contiguous(pointer(T) f0, pointer(T) f1, N n, std::true_type)
+  {
+    // Precondition: mutable_counted_range(f0, n)
+    // Precondition: mutable_counted_range(f1, n)
+    // Precondition: the two ranges are disjoint
+    swap_bytes(reinterpret_cast<char*>(f0), reinterpret_cast<char*>(f1), std::size_t(n) * sizeof(T));
+    return std::make_pair(f0 + n, f1 + n);
+  }
+
+  template<typename T, typename N>
+    requires(Integer(N))
+  std::pair<pointer(T), pointer(T)>
+  swap_ranges_n_contiguous(pointer(T) f0, pointer(T) f1, N n, std::false_type)
+  {
+    // Precondition: mutable_counted_range(f0, n)
+    // Precondition: mutable_counted_range(f1, n)
+    while(count_down(n)) swap_step(f0, f1);
+    return std::make_pair(f0, f1);
+  }
+
+  template<typename T, typename N>
+    requires(Integer(N))
+  std::pair<pointer(T), pointer(T)> swap_ranges_n(pointer(T) f0, pointer(T) f1, N n)
+  {
+    // Precondition: mutable_counted_range(f0, n)
+    // Precondition: mutable_counted_range(f1, n)
+    // Precondition: the two ranges are disjoint
+    return swap_ranges_n_contiguous(f0, f1, n, std::is_trivially_copyable<T>());
+  }
+
+  template<typename T, typename N>
+    requires(Integer(N))
+  std::pair<pointer(T), pointer(T)> swap_ranges_n_streaming(pointer(T) f0, pointer(T) f1, N n)
+  {
+    // Precondition: mutable_counted_range(f0, n)
+    // Precondition: mutable_counted_range(f1, n)
+    // Precondition: the two ranges are disjoint
+    static_assert(std::is_trivially_copyable<T>::value, "swap_ranges_n_streaming swaps bytes");
+    std::size_t b = std::size_t(n) * sizeof(T);
+    if (b < streaming_copy_threshold_bytes) return swap_ranges_n(f0, f1, n);
+    swap_bytes_streaming(reinterpret_cast<char*>(f0), reinterpret_cast<char*>(f1), b);
+    return std::make_pair(f0 + n, f1 + n);
+  }
+
   
   // *******************************************************
   // Chapter 10 - Rearrangements
@@ -3306,6 +5300,22 @@ namespace eop {
     }
   }
 
+  template<typename T>
+    requires(Mutable(pointer(T)))
+  void reverse_n_random_access(pointer(T) f, DistanceType(pointer(T)) n)
+  {
+    //Precondition: mutable_counted_range(f, n)
+    reverse_swap_ranges_n(f + n, f, half_nonnegative(n));
+  }
+
+  template<typename T>
+    requires(Mutable(pointer(T)))
+  void reverse_n_indexed(pointer(T) f, DistanceType(pointer(T)) n)
+  {
+    //Precondition: mutable_counted_range(f, n)
+    reverse_swap_ranges_n(f + n, f, half_nonnegative(n));
+  }
+
   template<typename I>
     requires(Mutable(I) && BidirectionalIterator(I))
   void reverse_bidirectional(I f, I l)
@@ -3537,6 +5547,76 @@ namespace eop {
     return eop::copy(f_b, l_b, f);
   }
 
+  // A rotate_plan records what rotate_cycles derives from the shape of a
+  // k-rotation of n elements, so that rotating many ranges of the same shape
+  // computes the gcd once. Cycles starting at adjacent leaders run in
+  // parallel, so the plan advances `block` of them together and every step
+  // moves a contiguous run of elements instead of a single one. This only
+  // pays when there are many short cycles; otherwise the cycles stride
+  // through the whole range and the plan falls back to the sequential
+  // swapping of rotate_forward_nontrivial.
+
+  const int rotate_plan_max_block = 64;
+
+  template<typename N>
+    requires(Integer(N))
+  struct rotate_plan
+  {
+    N n;     // length of the range
+    N k;     // the element at index i moves to (i + k) mod n
+    N d;     // number of cycles; their leaders are 0, 1, ..., d - 1
+    N block; // number of adjacent cycles advanced together, 0 if swapping
+    rotate_plan(N n, N k, N max_block = N(rotate_plan_max_block)) :
+      n(n), k(k), d(gcd(k, n - k)), block(N(0))
+    {
+      // Precondition: 0 < k < n && 0 < max_block <= rotate_plan_max_block
+      if (max_block <= d && n / d <= max_block) block = max_block;
+    }
+    N operator()(N i) const
+    {
+      // from-permutation of the k-rotation on indices
+      return i < k ? i + (n - k) : i - k;
+    }
+  };
+
+  template<typename I, typename N>
+    requires(Mutable(I) && RandomAccessIterator(I) && Integer(N))
+  void rotate_cycle_blocks(I f, const rotate_plan<N>& plan, N i, N b)
+  {
+    // Precondition: mutable_counted_range(f, plan.n)
+    // Precondition: i + b <= plan.d && 0 < b <= rotate_plan_max_block
+    // Leaders i, ..., i + b - 1 stay within one window of plan.d elements
+    // along their cycles, so each run of b elements is contiguous
+    typedef typename std::decay<decltype(source(f))>::type T;
+    T tmp[rotate_plan_max_block];
+    eop::copy_n(f + i, b, tmp);
+    N j = i;
+    N from = plan(j);
+    while (from != i) {
+      eop::copy_n(f + from, b, f + j);
+      j = from;
+      from = plan(j);
+    }
+    eop::copy_n(tmp, b, f + j);
+  }
+
+  template<typename I, typename N>
+    requires(Mutable(I) && RandomAccessIterator(I) && Integer(N))
+  I rotate_with_plan(I f, const rotate_plan<N>& plan)
+  {
+    // Precondition: mutable_counted_range(f, plan.n)
+    if (zero(plan.block))
+      return rotate_forward_nontrivial(f, f + (plan.n - plan.k), f + plan.n);
+    N i(0);
+    while (i < plan.d) {
+      N b = plan.d - i;
+      if (plan.block < b) b = plan.block;
+      rotate_cycle_blocks(f, plan, i, b);
+      i = i + b;
+    }
+    return f + plan.k;
+  }
+
   // 10.5 Algorithm Selection
 
   template<typename I>
@@ -3547,18 +5627,55 @@ namespace eop {
     reverse_n_indexed(f, l - f);
   }
 
-  template<typename I>
+  // A temporary_buffer holds as many of the n elements asked for as can be
+  // allocated, halving the request each time the allocation fails, so the
+  // memory-adaptive algorithms use whatever memory is available
+
+  template<typename T>
+    requires(Regular(T))
   struct temporary_buffer
   {
+    typedef pointer(T) P;
+    typedef DistanceType(P) N;
+    P p;
+    N n;
+    temporary_buffer(N k) : p(0), n(k)
+    {
+      while (!zero(n)) {
+        p = new (std::nothrow) T[n];
+        if (p != 0) break;
+        n = half_nonnegative(n);
+      }
+    }
+    temporary_buffer(const temporary_buffer&) = delete;
+    temporary_buffer& operator=(const temporary_buffer&) = delete;
+    ~temporary_buffer()
+    {
+      delete[] p;
+    }
   };
 
+  template<typename T>
+    requires(Regular(T))
+  pointer(T) begin(temporary_buffer<T>& b)
+  {
+    return b.p;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  DistanceType(pointer(T)) size(const temporary_buffer<T>& b)
+  {
+    return b.n;
+  }
+
   template<typename I>
     requires(Mutable(I) && ForwardIterator(I))
   void reverse_n_with_temporary_buffer(I f, DistanceType(I) n)
   {
     // Precondition: mutable_counted_range(f, n)
     temporary_buffer<ValueType(I)> b(n);
-    reverse_n_apadtive(f, n, begin(b), size(b));
+    reverse_n_adaptive(f, n, begin(b), size(b));
   }
 
   template<typename I>
@@ -3716,8 +5833,8 @@ namespace eop {
   {
     // Precondition: mutable_bounded_range(f, l)
     while (true) {
-      f = find_if(f, l, p);
-      l = find_backward_if_not(f, l, p);
+      f = eop::find_if(f, l, p);
+      l = eop::find_backward_if_not(f, l, p);
       if (f == l) return f;
       reverse_swap_step(l, f);
     }
@@ -3735,10 +5852,10 @@ namespace eop {
   {
     //Precondition: mutable_bounded_range(f, l)
     I m = potential_partition_point(f, l, p);
-    I i;
+    I i = m;
     while (true) {
       f = find_if(f, m, p);
-      i = find_if_not(m, l, p);
+      i = find_if_not(i, l, p);
       if (f == m || i == l) return m;
       swap_step(f, i);
     }
@@ -3786,6 +5903,112 @@ namespace eop {
     return f;
   }
 
+  // Block partition (Edelkamp and Weiss, BlockQuicksort): the predicate is
+  // applied to a block of partition_block_size elements at each end, and the
+  // offsets of the misplaced ones are stored unconditionally, advancing the
+  // count by the result of the predicate, so the scan has no branch that
+  // depends on the data. The misplaced elements are then exchanged in bulk by
+  // one cycle, as in partition_single_cycle.
+
+  const int partition_block_size = 128;
+
+  template<typename I, typename P>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             UnaryPredicate(P) && ValueType(I) == Domain(P))
+  I partition_block(I f, I l, P p)
+  {
+    // Precondition: mutable_bounded_range(f, l)
+    typedef typename std::decay<decltype(source(f))>::type T;
+    typedef DistanceType(I) N;
+    const N b = N(partition_block_size);
+    unsigned char offsets_f[partition_block_size];
+    unsigned char offsets_l[partition_block_size];
+    N n_f(0), n_l(0); // misplaced elements left in each block
+    N s_f(0), s_l(0); // first of them in the offset buffers
+    while (b + b < l - f) {
+      if (n_f == N(0)) {
+        s_f = N(0);
+        for (N i(0); i != b; i = successor(i)) {
+          offsets_f[n_f] = (unsigned char)(i);
+          n_f = n_f + N(p(source(f + i)));
+        }
+      }
+      if (n_l == N(0)) {
+        s_l = N(0);
+        for (N i(0); i != b; i = successor(i)) {
+          offsets_l[n_l] = (unsigned char)(i);
+          n_l = n_l + N(!p(source(l - successor(i))));
+        }
+      }
+      N m = n_f < n_l ? n_f : n_l;
+      if (m != N(0)) {
+        // Exchange the first m misplaced elements of the two blocks by one
+        // cycle through a hole: m + m + 1 assignments instead of 3m
+        I i = f + N(offsets_f[s_f]);
+        I j = l - successor(N(offsets_l[s_l]));
+        T hole = source(i);
+        sink(i) = source(j);
+        for (N k(1); k != m; k = successor(k)) {
+          i = f + N(offsets_f[s_f + k]);
+          sink(j) = source(i);
+          j = l - successor(N(offsets_l[s_l + k]));
+          sink(i) = source(j);
+        }
+        sink(j) = hole;
+      }
+      n_f = n_f - m; s_f = s_f + m;
+      n_l = n_l - m; s_l = s_l + m;
+      if (n_f == N(0)) f = f + b;
+      if (n_l == N(0)) l = l - b;
+    }
+    // The elements outside [f, l) are in place, and at most two blocks
+    // remain
+    return partition_bidirectional(f, l, p);
+  }
+
+  // The partitions that need not be stable, selected by the iterator concept
+
+  template<typename I, typename P>
+    requires(Mutable(I) && ForwardIterator(I) &&
+             UnaryPredicate(P) && ValueType(I) == Domain(P))
+  I partition_unstable(I f, I l, P p, forward_iterator_tag)
+  {
+    return partition_forward(f, l, p);
+  }
+
+  template<typename I, typename P>
+    requires(Mutable(I) && BidirectionalIterator(I) &&
+             UnaryPredicate(P) && ValueType(I) == Domain(P))
+  I partition_unstable(I f, I l, P p, bidirectional_iterator_tag)
+  {
+    return partition_bidirectional(f, l, p);
+  }
+
+  template<typename I, typename P>
+    requires(Mutable(I) && IndexedIterator(I) &&
+             UnaryPredicate(P) && ValueType(I) == Domain(P))
+  I partition_unstable(I f, I l, P p, indexed_iterator_tag)
+  {
+    return partition_forward(f, l, p);
+  }
+
+  template<typename I, typename P>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             UnaryPredicate(P) && ValueType(I) == Domain(P))
+  I partition_unstable(I f, I l, P p, random_access_iterator_tag)
+  {
+    return partition_block(f, l, p);
+  }
+
+  template<typename I, typename P>
+    requires(Mutable(I) && ForwardIterator(I) &&
+             UnaryPredicate(P) && ValueType(I) == Domain(P))
+  I partition_unstable(I f, I l, P p)
+  {
+    // Precondition: mutable_bounded_range(f, l)
+    return partition_unstable(f, l, p, IteratorConcept<I>());
+  }
+
   template<typename I, typename B, typename P>
     requires(Mutable(I) && ForwardIterator(I) &&
              Mutable(B) && ForwardIterator(B) &&
@@ -3890,6 +6113,190 @@ namespace eop {
     return partition_stable_n_adaptive_nonempty(f_i, n_i, f_b, n_b, p);
   }
 
+  // Partitions into more than two classes. The three-way partitions split
+  // a range by a relation into the elements that precede a, those
+  // equivalent to it and those that follow it; the bucket partitions split
+  // it by a key function into k buckets. Each is in place and unstable, or
+  // stable with a buffer as large as the range.
+
+  template<typename I, typename R>
+    requires(Mutable(I) && BidirectionalIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  std::pair<I, I> partition_three_way_bidirectional(I f, I l, const Domain(R)& a, R r)
+  {
+    // Precondition: mutable_bounded_range(f, l) && weak_ordering(r)
+    // Precondition: a does not refer into [f, l)
+    // Dijkstra's Dutch national flag: [f, m0) precedes a, [m0, i) is
+    // equivalent to a, [i, m1) is still to be seen and [m1, l) follows a
+    I m0 = f;
+    I i = f;
+    I m1 = l;
+    while (i != m1) {
+      if (r(source(i), a)) {
+        exchange_values(m0, i);
+        m0 = successor(m0);
+        i = successor(i);
+      } else if (r(a, source(i))) {
+        m1 = predecessor(m1);
+        exchange_values(i, m1);
+      } else {
+        i = successor(i);
+      }
+    }
+    return std::pair<I, I>(m0, m1);
+    // Postcondition: [f, m0) precedes a, [m0, m1) is equivalent to a
+    //                and [m1, l) follows a under r
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && BidirectionalIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  std::pair<I, I> partition_three_way(I f, I l, const Domain(R)& a, R r,
+                                      bidirectional_iterator_tag)
+  {
+    return partition_three_way_bidirectional(f, l, a, r);
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  std::pair<I, I> partition_three_way(I f, I l, const Domain(R)& a, R r,
+                                      random_access_iterator_tag)
+  {
+    // Two passes of the branchless partition_block do fewer exchanges
+    // than one pass of the Dutch flag whose three-way branch cannot be
+    // predicted
+    I m0 = partition_block(f, l, lower_bound_predicate<R>(a, r));
+    I m1 = partition_block(m0, l, upper_bound_predicate<R>(a, r));
+    return std::pair<I, I>(m0, m1);
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && BidirectionalIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  std::pair<I, I> partition_three_way(I f, I l, const Domain(R)& a, R r)
+  {
+    // Precondition: mutable_bounded_range(f, l) && weak_ordering(r)
+    // Precondition: a does not refer into [f, l)
+    return partition_three_way(f, l, a, r, IteratorConcept<I>());
+  }
+
+  template<typename I, typename B, typename R>
+    requires(Mutable(I) && ForwardIterator(I) &&
+             Mutable(B) && ForwardIterator(B) &&
+             ValueType(I) == ValueType(B) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  std::pair<I, I> partition_three_way_stable_with_buffer(I f, I l, B f_b,
+                                                         const Domain(R)& a, R r)
+  {
+    // Precondition: mutable_bounded_range(f, l) && weak_ordering(r)
+    // Precondition: mutable_counted_range(f_b, l - f)
+    // Precondition: a does not refer into [f, l) or the buffer
+    // The elements that do not precede a go to the buffer, and from there
+    // the equivalent ones come back while the following ones are packed at
+    // the front of the buffer
+    std::pair<I, B> x = eop::partition_copy(f, l, f, f_b, lower_bound_predicate<R>(a, r));
+    std::pair<I, B> y = eop::partition_copy(f_b, x.second, x.first, f_b, upper_bound_predicate<R>(a, r));
+    eop::copy(f_b, y.second, y.first);
+    return std::pair<I, I>(x.first, y.first);
+  }
+
+  template<typename I, typename K, typename O>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             UnaryFunction(K) && ValueType(I) == Domain(K) &&
+             Integer(Codomain(K)) &&
+             Writable(O) && Iterator(O) && ValueType(O) == I)
+  O partition_buckets_n(I f, DistanceType(I) n, K key, int k, O o)
+  {
+    // Precondition: mutable_counted_range(f, n)
+    // Precondition: key maps each element of the range into [0, k)
+    // Postcondition: the elements are grouped by key in increasing order;
+    // writes to o the k + 1 bounds f, ..., f + n of the buckets
+    // The elements are permuted into their buckets in place by following
+    // cycles from the head of each bucket, as in radix_sort_msd_n
+    typedef typename std::decay<decltype(source(f))>::type T;
+    typedef DistanceType(I) N;
+    std::vector<N> heads(k, N(0));
+    std::vector<N> tails(k);
+    for (N i(0); i != n; i = successor(i)) {
+      int d = int(key(source(f + i)));
+      heads[d] = successor(heads[d]);
+    }
+    N sum(0);
+    for (int d = 0; d != k; ++d) {
+      N c = heads[d];
+      heads[d] = sum;
+      sink(o) = f + sum;
+      o = successor(o);
+      sum = sum + c;
+      tails[d] = sum;
+    }
+    sink(o) = f + n;
+    o = successor(o);
+    for (int b = 0; b != k; ++b) {
+      while (heads[b] != tails[b]) {
+        T x = source(f + heads[b]);
+        int d = int(key(x));
+        while (d != b) {
+          T y = source(f + heads[d]);
+          sink(f + heads[d]) = x;
+          heads[d] = successor(heads[d]);
+          x = y;
+          d = int(key(x));
+        }
+        sink(f + heads[b]) = x;
+        heads[b] = successor(heads[b]);
+      }
+    }
+    return o;
+  }
+
+  template<typename I, typename B, typename K, typename O>
+    requires(Mutable(I) && ForwardIterator(I) &&
+             Mutable(B) && RandomAccessIterator(B) &&
+             ValueType(I) == ValueType(B) &&
+             UnaryFunction(K) && ValueType(I) == Domain(K) &&
+             Integer(Codomain(K)) &&
+             Writable(O) && Iterator(O) && ValueType(O) == I)
+  O partition_buckets_stable_n_with_buffer(I f, DistanceType(I) n, B f_b, K key, int k, O o)
+  {
+    // Precondition: mutable_counted_range(f, n) && mutable_counted_range(f_b, n)
+    // Precondition: key maps each element of the range into [0, k)
+    // Postcondition: the elements are grouped stably by key in increasing
+    // order; writes to o the k + 1 bounds f, ..., f + n of the buckets
+    // A counting pass places each bucket in the buffer, and the elements
+    // are scattered there and copied back
+    typedef DistanceType(I) N;
+    std::vector<N> offsets(k, N(0));
+    I i = f;
+    for (N j(0); j != n; j = successor(j)) {
+      int d = int(key(source(i)));
+      offsets[d] = successor(offsets[d]);
+      i = successor(i);
+    }
+    N sum(0);
+    i = f;
+    for (int d = 0; d != k; ++d) {
+      N c = offsets[d];
+      offsets[d] = sum;
+      sink(o) = i;
+      o = successor(o);
+      i = i + c;
+      sum = sum + c;
+    }
+    sink(o) = i;
+    o = successor(o);
+    i = f;
+    for (N j(0); j != n; j = successor(j)) {
+      int d = int(key(source(i)));
+      sink(f_b + offsets[d]) = source(i);
+      offsets[d] = successor(offsets[d]);
+      i = successor(i);
+    }
+    eop::copy_n(f_b, n, f);
+    return o;
+  }
+
   // 11.2 Balanced Reduction
 
   template<typename I, typename P>
@@ -3995,5 +6402,1187 @@ namespace eop {
     ).first;
   }
 
+  // 11.3 Merging
+
+  template<typename I, typename B, typename R>
+    requires(Mutable(I) && ForwardIterator(I) &&
+             Mutable(B) && ForwardIterator(B) &&
+             ValueType(I) == ValueType(B) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  I merge_n_with_buffer(I f0, DistanceType(I) n0, I f1, DistanceType(I) n1, B f_b, R r)
+  {
+    // Precondition: mergeable(f0, n0, f1, n1, r)
+    // Precondition: mutable_counted_range(f_b, n0)
+    copy_n(f0, n0, f_b);
+    return std::get<2>(merge_copy_n(f_b, n0, f1, n1, f0, r));
+  }
+
+  template<typename I, typename B, typename R>
+    requires(Mutable(I) && ForwardIterator(I) &&
+             Mutable(B) && ForwardIterator(B) &&
+             ValueType(I) == ValueType(B) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  I sort_n_with_buffer(I f, DistanceType(I) n, B f_b, R r)
+  {
+    // Precondition: mutable_counted_range(f, n) && weak_ordering(r)
+    // Precondition: mutable_counted_range(f_b, ceiling(n / 2))
+    // Postcondition: the range is sorted stably by r
+    DistanceType(I) h = half_nonnegative(n);
+    if (zero(h)) return f + n;
+    I m = sort_n_with_buffer(f, h, f_b, r);
+    sort_n_with_buffer(m, n - h, f_b, r);
+    return merge_n_with_buffer(f, h, m, n - h, f_b, r);
+  }
+
+  // Merging without a buffer for the whole of the first range: the ranges
+  // are split by a rotation into two pairs of ranges that can be merged
+  // separately, until the first range of a pair fits the buffer.
+  // merge_n_step_0 splits the longer first range in half and finds the
+  // place of its middle element in the second range, merge_n_step_1 the
+  // other way round.
+
+  template<typename I, typename R>
+    requires(Mutable(I) && ForwardIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  void merge_n_step_0(I f0, DistanceType(I) n0, I f1, DistanceType(I) n1, R r,
+                      I& f0_0, DistanceType(I)& n0_0, I& f0_1, DistanceType(I)& n0_1,
+                      I& f1_0, DistanceType(I)& n1_0, I& f1_1, DistanceType(I)& n1_1)
+  {
+    // Precondition: mergeable(f0, n0, f1, n1, r)
+    f0_0 = f0;
+    n0_0 = half_nonnegative(n0);
+    f0_1 = f0_0 + n0_0;
+    f1_1 = lower_bound_n(f1, n1, source(f0_1), r);
+    f1_0 = eop::rotate(f0_1, f1, f1_1);
+    n0_1 = f1_0 - f0_1;
+    f1_0 = successor(f1_0);
+    n1_0 = predecessor(n0 - n0_0);
+    n1_1 = n1 - n0_1;
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && ForwardIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  void merge_n_step_1(I f0, DistanceType(I) n0, I f1, DistanceType(I) n1, R r,
+                      I& f0_0, DistanceType(I)& n0_0, I& f0_1, DistanceType(I)& n0_1,
+                      I& f1_0, DistanceType(I)& n1_0, I& f1_1, DistanceType(I)& n1_1)
+  {
+    // Precondition: mergeable(f0, n0, f1, n1, r)
+    f0_0 = f0;
+    n0_1 = half_nonnegative(n1);
+    f1_1 = f1 + n0_1;
+    f0_1 = upper_bound_n(f0, n0, source(f1_1), r);
+    f1_1 = successor(f1_1);
+    f1_0 = eop::rotate(f0_1, f1, f1_1);
+    n0_0 = f0_1 - f0_0;
+    n1_0 = n0 - n0_0;
+    n1_1 = predecessor(n1 - n0_1);
+  }
+
+  template<typename I, typename B, typename R>
+    requires(Mutable(I) && ForwardIterator(I) &&
+             Mutable(B) && ForwardIterator(B) &&
+             ValueType(I) == ValueType(B) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  I merge_n_adaptive(I f0, DistanceType(I) n0, I f1, DistanceType(I) n1,
+                     B f_b, DistanceType(B) n_b, R r)
+  {
+    // Precondition: mergeable(f0, n0, f1, n1, r)
+    // Precondition: mutable_counted_range(f_b, n_b)
+    // Postcondition: the merged range is sorted stably by r; with n_b == 0
+    // no buffer is used
+    typedef DistanceType(I) N;
+    if (zero(n0) || zero(n1)) return f0 + n0 + n1;
+    if (n0 <= N(n_b)) return merge_n_with_buffer(f0, n0, f1, n1, f_b, r);
+    I f0_0; I f0_1; I f1_0; I f1_1;
+    N n0_0; N n0_1; N n1_0; N n1_1;
+    if (n0 < n1) merge_n_step_0(f0, n0, f1, n1, r,
+                                f0_0, n0_0, f0_1, n0_1,
+                                f1_0, n1_0, f1_1, n1_1);
+    else         merge_n_step_1(f0, n0, f1, n1, r,
+                                f0_0, n0_0, f0_1, n0_1,
+                                f1_0, n1_0, f1_1, n1_1);
+    merge_n_adaptive(f0_0, n0_0, f0_1, n0_1, f_b, n_b, r);
+    return merge_n_adaptive(f1_0, n1_0, f1_1, n1_1, f_b, n_b, r);
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  void merge_symmetric(I f, I m, I l, R r)
+  {
+    // Precondition: mergeable(f, m - f, m, l - m, r)
+    // Postcondition: [f, l) is sorted stably by r, in place
+    // SymMerge (Kim and Kutzner): with h the middle of [f, l), a binary
+    // search over pairs of elements placed symmetrically about m finds the
+    // rotation [s, m) [m, e) -> [m, e) [s, m) with (s - f) + (e - m) == h,
+    // after which [f, f + h) and [f + h, l) are merged separately. Only the
+    // first is merged by recursion, so the depth is logarithmic
+    typedef DistanceType(I) N;
+    while (f != m && m != l) {
+      N n = l - f;
+      N h = half_nonnegative(n);
+      N k = h + (m - f);
+      // Find the least i in [i_0, i_1) such that source(f + k - 1 - i)
+      // precedes source(f + i); the elements of [f + i, m) then follow the
+      // elements of [m, f + k - i) in the merged order
+      N i_0 = h < m - f ? k - n : N(0);
+      N i_1 = h < m - f ? h : m - f;
+      while (i_0 < i_1) {
+        N c = i_0 + half_nonnegative(i_1 - i_0);
+        if (r(source(f + (k - 1 - c)), source(f + c))) i_1 = c;
+        else i_0 = successor(c);
+      }
+      I s = f + i_0;
+      I e = f + (k - i_0);
+      eop::rotate(s, m, e);
+      merge_symmetric(f, s, f + h, r);
+      m = e;
+      f = f + h;
+    }
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && ForwardIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  I merge_n(I f0, DistanceType(I) n0, I f1, DistanceType(I) n1, R r)
+  {
+    // Precondition: mergeable(f0, n0, f1, n1, r)
+    // Postcondition: the merged range is sorted stably by r
+    // Uses a buffer for as much of the first range as can be allocated
+    typedef typename std::decay<decltype(source(f0))>::type T;
+    temporary_buffer<T> b(n0);
+    return merge_n_adaptive(f0, n0, f1, n1, begin(b), size(b), r);
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && ForwardIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  I merge_n_sqrt_buffer(I f0, DistanceType(I) n0, I f1, DistanceType(I) n1, R r)
+  {
+    // Precondition: mergeable(f0, n0, f1, n1, r)
+    // Postcondition: the merged range is sorted stably by r
+    // With a buffer of about sqrt(n0 + n1) elements the rotations stop at
+    // blocks of that size, halving the depth of the recursion of the
+    // merge without a buffer
+    typedef typename std::decay<decltype(source(f0))>::type T;
+    typedef DistanceType(I) N;
+    N n = n0 + n1;
+    N k(1);
+    while (k * k < n) k = twice(k);
+    temporary_buffer<T> b(k);
+    return merge_n_adaptive(f0, n0, f1, n1, begin(b), size(b), r);
+  }
+
+  template<typename I, typename B, typename R>
+    requires(Mutable(I) && ForwardIterator(I) &&
+             Mutable(B) && ForwardIterator(B) &&
+             ValueType(I) == ValueType(B) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  I sort_n_adaptive(I f, DistanceType(I) n, B f_b, DistanceType(B) n_b, R r)
+  {
+    // Precondition: mutable_counted_range(f, n) && weak_ordering(r)
+    // Precondition: mutable_counted_range(f_b, n_b)
+    // Postcondition: the range is sorted stably by r
+    DistanceType(I) h = half_nonnegative(n);
+    if (zero(h)) return f + n;
+    I m = sort_n_adaptive(f, h, f_b, n_b, r);
+    sort_n_adaptive(m, n - h, f_b, n_b, r);
+    return merge_n_adaptive(f, h, m, n - h, f_b, n_b, r);
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && ForwardIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  I sort_stable_n(I f, DistanceType(I) n, R r)
+  {
+    // Precondition: mutable_counted_range(f, n) && weak_ordering(r)
+    // Postcondition: the range is sorted stably by r
+    typedef typename std::decay<decltype(source(f))>::type T;
+    temporary_buffer<T> b(half_nonnegative(n));
+    return sort_n_adaptive(f, n, begin(b), size(b), r);
+  }
+
+  // *******************************************************
+  // Order selection on ranges (extends Chapter 4)
+  // *******************************************************
+
+  // select_n(f, n, k, r) rearranges the counted range so that f + k holds the
+  // element that would be there if the range were sorted by r, with no
+  // greater element before it and no lesser element after it.
+
+  template<typename I, typename R>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  void insertion_sort_n(I f, DistanceType(I) n, R r)
+  {
+    // Precondition: mutable_counted_range(f, n) && weak_ordering(r)
+    typedef typename std::decay<decltype(source(f))>::type T;
+    typedef DistanceType(I) N;
+    for (N i(1); i < n; i = successor(i)) {
+      I j = f + i;
+      T x = source(j);
+      while (j != f && r(x, source(predecessor(j)))) {
+        sink(j) = source(predecessor(j));
+        j = predecessor(j);
+      }
+      sink(j) = x;
+    }
+  }
+
+  template<typename I, typename R>
+    requires(Readable(I) && RandomAccessIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  I median_5_n(I f, R r)
+  {
+    // Precondition: readable_counted_range(f, 5) && weak_ordering(r)
+    relation_source<I, I, R> rs(r);
+    I a = f;     I b = f + 1;
+    I c = f + 2; I d = f + 3;
+    I e = f + 4;
+    return median_5(a, b, c, d, e, rs);
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  I select_n_median_of_medians(I f, DistanceType(I) n, DistanceType(I) k, R r)
+  {
+    // Precondition: mutable_counted_range(f, n) && 0 <= k < n
+    // Precondition: weak_ordering(r)
+    // Worst case: O(n) applications of r
+    typedef DistanceType(I) N;
+    while (N(8) < n) {
+      // Gather the medians of the groups of five at the front
+      N g = n / N(5);
+      for (N i(0); i < g; i = successor(i))
+        exchange_values(f + i, median_5_n(f + N(5) * i, r));
+      ValueType(I) a = source(select_n_median_of_medians(f, g, half_nonnegative(g), r));
+      std::pair<I, I> p = partition_three_way(f, f + n, a, r, random_access_iterator_tag());
+      N i0 = p.first - f;
+      N i1 = p.second - f;
+      if (k < i0) {
+        n = i0;
+      } else if (k < i1) {
+        return f + k;
+      } else {
+        f = p.second;
+        k = k - i1;
+        n = n - i1;
+      }
+    }
+    insertion_sort_n(f, n, r);
+    return f + k;
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  I select_n_introselect(I f, DistanceType(I) n, DistanceType(I) k, R r)
+  {
+    // Precondition: mutable_counted_range(f, n) && 0 <= k < n
+    // Precondition: weak_ordering(r)
+    // Falls back to median of medians after 2 log(n) partitions,
+    // so the worst case is O(n) as well
+    typedef DistanceType(I) N;
+    N budget(0);
+    for (N m = n; N(1) < m; m = half_nonnegative(m)) budget = budget + N(2);
+    while (N(16) < n) {
+      if (zero(budget)) return select_n_median_of_medians(f, n, k, r);
+      budget = predecessor(budget);
+      I l = f + n;
+      ValueType(I) a = select_1_3(source(f), source(f + half_nonnegative(n)),
+                                  source(predecessor(l)), r);
+      I m = partition_bidirectional(f, l, lower_bound_predicate<R>(a, r));
+      N i = m - f;
+      if (zero(i)) {
+        // a is a minimum: split off the elements equivalent to it
+        m = partition_bidirectional(f, l, upper_bound_predicate<R>(a, r));
+        i = m - f;
+        if (k < i) return f + k;
+      }
+      if (k < i) {
+        n = i;
+      } else {
+        f = m;
+        k = k - i;
+        n = n - i;
+      }
+    }
+    insertion_sort_n(f, n, r);
+    return f + k;
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  I select_n(I f, DistanceType(I) n, DistanceType(I) k, R r)
+  {
+    // Precondition: mutable_counted_range(f, n) && 0 <= k < n
+    // Precondition: weak_ordering(r)
+    return select_n_introselect(f, n, k, r);
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  I select(I f, I m, I l, R r)
+  {
+    // Precondition: mutable_bounded_range(f, l) && m in [f, l]
+    // Precondition: weak_ordering(r)
+    if (m == l) return m;
+    return select_n(f, l - f, m - f, r);
+  }
+
+  // *******************************************************
+  // Sorting random-access ranges
+  // *******************************************************
+
+  // sort_n is pattern-defeating quicksort (Peters): the introselect loop
+  // with the pivot taken by median_5 or select_1_3, the branchless
+  // partition_block, insertion sort for short ranges and heap sort once too
+  // many partitions were unbalanced. Runs of equivalent elements are split
+  // off in one partition, and ranges found already partitioned are tried
+  // by an insertion sort that gives up after a few moves, so sorted and
+  // nearly sorted input takes linear time.
+
+  const int sort_insertion_threshold = 24;
+  const int sort_median_5_threshold = 128;
+  const int sort_move_limit = 8;
+
+  template<typename I, typename R>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  void sift_down_n(I f, DistanceType(I) n, DistanceType(I) i, R r)
+  {
+    // Precondition: mutable_counted_range(f, n) && 0 <= i < n
+    // Precondition: the subtrees of i are heaps under r
+    // Postcondition: the subtree of i is a heap under r
+    // Floyd: the hole goes down to a leaf along the greater successors, and
+    // the element climbs back from there, saving a comparison per level
+    typedef typename std::decay<decltype(source(f))>::type T;
+    typedef DistanceType(I) N;
+    T x = source(f + i);
+    N k = i;
+    N c = twice(k) + N(1);
+    while (c < n) {
+      if (successor(c) < n && r(source(f + c), source(f + successor(c)))) c = successor(c);
+      sink(f + k) = source(f + c);
+      k = c;
+      c = twice(k) + N(1);
+    }
+    while (i < k) {
+      N p = half_nonnegative(predecessor(k));
+      if (!r(source(f + p), x)) break;
+      sink(f + k) = source(f + p);
+      k = p;
+    }
+    sink(f + k) = x;
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  void heap_sort_n(I f, DistanceType(I) n, R r)
+  {
+    // Precondition: mutable_counted_range(f, n) && weak_ordering(r)
+    // Worst case: O(n log n) applications of r
+    typedef DistanceType(I) N;
+    for (N i = half_nonnegative(n); N(0) < i; i = predecessor(i))
+      sift_down_n(f, n, predecessor(i), r);
+    for (N m = n; N(1) < m; ) {
+      m = predecessor(m);
+      exchange_values(f, f + m);
+      sift_down_n(f, m, N(0), r);
+    }
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  bool insertion_sort_n_bounded(I f, DistanceType(I) n, R r)
+  {
+    // Precondition: mutable_counted_range(f, n) && weak_ordering(r)
+    // Postcondition: returns whether the range is sorted; gives up once
+    // more than sort_move_limit elements have been moved
+    typedef typename std::decay<decltype(source(f))>::type T;
+    typedef DistanceType(I) N;
+    N moves(0);
+    for (N i(1); i < n; i = successor(i)) {
+      I j = f + i;
+      if (!r(source(j), source(predecessor(j)))) continue;
+      T x = source(j);
+      do {
+        sink(j) = source(predecessor(j));
+        j = predecessor(j);
+      } while (j != f && r(x, source(predecessor(j))));
+      sink(j) = x;
+      moves = moves + (f + i - j);
+      if (N(sort_move_limit) < moves) return false;
+    }
+    return true;
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  I sort_pivot(I f, DistanceType(I) n, R r)
+  {
+    // Precondition: readable_counted_range(f, n) && 3 <= n
+    // Postcondition: returns the median of 5 elements spread over a large
+    // range, or of its first, middle and last elements
+    typedef DistanceType(I) N;
+    relation_source<I, I, R> rs(r);
+    I l = predecessor(f + n);
+    I m = f + half_nonnegative(n);
+    if (n < N(sort_median_5_threshold)) return select_1_3(f, m, l, rs);
+    N q = n / N(4);
+    I a = f + q;
+    I b = m + q;
+    return median_5(f, a, m, b, l, rs);
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  void sort_n_pattern_defeating(I f, DistanceType(I) n, R r,
+                                DistanceType(I) budget, bool leftmost)
+  {
+    // Precondition: mutable_counted_range(f, n) && weak_ordering(r)
+    // Precondition: leftmost or no element of the range precedes
+    // source(predecessor(f))
+    typedef typename std::decay<decltype(source(f))>::type T;
+    typedef DistanceType(I) N;
+    while (N(sort_insertion_threshold) < n) {
+      I l = f + n;
+      exchange_values(f, sort_pivot(f, n, r));
+      T a = source(f);
+      if (!leftmost && !r(source(predecessor(f)), a)) {
+        // a is equivalent to the element before the range, which precedes
+        // none of it, so the elements equivalent to a are in place
+        f = partition_block(successor(f), l, upper_bound_predicate<R>(a, r));
+        n = l - f;
+        continue;
+      }
+      // Skip the ends that are already on their side of a
+      lower_bound_predicate<R> p(a, r);
+      I i = successor(f);
+      while (i != l && !p(source(i))) i = successor(i);
+      I j = l;
+      while (j != i && p(source(predecessor(j)))) j = predecessor(j);
+      bool partitioned = i == j;
+      I k = predecessor(partitioned ? i : partition_block(i, j, p));
+      exchange_values(f, k);
+      N n0 = k - f;
+      N n1 = l - successor(k);
+      N e = n / N(8);
+      if (n0 < e || n1 < e) {
+        if (zero(budget)) {
+          heap_sort_n(f, n, r);
+          return;
+        }
+        budget = predecessor(budget);
+        // Unbalanced: move elements around in each part so that the
+        // pattern that caused it is unlikely to repeat
+        if (N(sort_insertion_threshold) < n0) {
+          exchange_values(f, f + n0 / N(4));
+          exchange_values(predecessor(k), k - n0 / N(4));
+        }
+        if (N(sort_insertion_threshold) < n1) {
+          exchange_values(successor(k), successor(k) + n1 / N(4));
+          exchange_values(predecessor(l), l - n1 / N(4));
+        }
+      } else if (partitioned &&
+                 insertion_sort_n_bounded(f, n0, r) &&
+                 insertion_sort_n_bounded(successor(k), n1, r)) {
+        return;
+      }
+      // Recur on the shorter part so that the depth is logarithmic
+      if (n0 < n1) {
+        sort_n_pattern_defeating(f, n0, r, budget, leftmost);
+        f = successor(k);
+        n = n1;
+        leftmost = false;
+      } else {
+        sort_n_pattern_defeating(successor(k), n1, r, budget, false);
+        n = n0;
+      }
+    }
+    insertion_sort_n(f, n, r);
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  void sort_n(I f, DistanceType(I) n, R r)
+  {
+    // Precondition: mutable_counted_range(f, n) && weak_ordering(r)
+    // Postcondition: the range is sorted by r, not necessarily stably
+    // Worst case: O(n log n) applications of r
+    typedef DistanceType(I) N;
+    N budget(0);
+    for (N m = n; N(1) < m; m = half_nonnegative(m)) budget = successor(budget);
+    sort_n_pattern_defeating(f, n, r, budget, true);
+  }
+
+  template<typename I, typename R>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             Relation(R) && ValueType(I) == Domain(R))
+  void sort(I f, I l, R r)
+  {
+    // Precondition: mutable_bounded_range(f, l) && weak_ordering(r)
+    sort_n(f, l - f, r);
+  }
+
+  // Radix sorts order elements by the bits of an arithmetic key rather
+  // than by a relation: radix_bits maps a key to an unsigned integer of the
+  // same size whose order is the order of the key, and the sorts take a
+  // byte of it at a time. The key of an element is given by a key function
+  // K, so records are sorted by one of their members.
+
+  template<typename T>
+    requires(Integer(T))
+  typename std::enable_if<std::is_unsigned<T>::value, T>::type radix_bits(T x)
+  {
+    return x;
+  }
+
+  template<typename T>
+    requires(Integer(T))
+  typename std::enable_if<std::is_signed<T>::value && std::is_integral<T>::value,
+                          typename std::make_unsigned<T>::type>::type radix_bits(T x)
+  {
+    // Flipping the sign bit puts the negative values first
+    typedef typename std::make_unsigned<T>::type U;
+    return U(U(x) ^ (U(1) << (8 * sizeof(T) - 1)));
+  }
+
+  inline std::uint32_t radix_bits(float x)
+  {
+    // Negative values have all their bits flipped, so that greater
+    // magnitudes come first, and nonnegative ones only the sign bit
+    std::uint32_t u;
+    std::memcpy(&u, &x, sizeof(u));
+    return u >> 31 ? ~u : u | (std::uint32_t(1) << 31);
+  }
+
+  inline std::uint64_t radix_bits(double x)
+  {
+    std::uint64_t u;
+    std::memcpy(&u, &x, sizeof(u));
+    return u >> 63 ? ~u : u | (std::uint64_t(1) << 63);
+  }
+
+  struct radix_identity
+  {
+    template<typename T>
+    const T& operator()(const T& x) const { return x; }
+  };
+
+  template<typename K>
+    requires(UnaryFunction(K))
+  struct radix_key_less
+  {
+    // The order in which the radix sorts leave the elements
+    K key;
+    radix_key_less(K key) : key(key) {}
+    template<typename T>
+    bool operator()(const T& x, const T& y) const
+    {
+      return radix_bits(key(x)) < radix_bits(key(y));
+    }
+  };
+
+  const int radix_digits = 256;
+  const int radix_insertion_threshold = 32;
+
+  template<typename I0, typename I1, typename N, typename K>
+    requires(Readable(I0) && RandomAccessIterator(I0) &&
+             Writable(I1) && RandomAccessIterator(I1) &&
+             ValueType(I0) == ValueType(I1) && Integer(N) &&
+             UnaryFunction(K) && ValueType(I0) == Domain(K))
+  void radix_scatter_n(I0 f_i, N n, I1 f_o, N* offsets, int shift, K key)
+  {
+    // Precondition: offsets[d] is where the first element with digit d
+    // goes in [f_o, f_o + n)
+    for (N i(0); i != n; i = successor(i)) {
+      int d = int((radix_bits(key(source(f_i + i))) >> shift) & (radix_digits - 1));
+      sink(f_o + offsets[d]) = source(f_i + i);
+      offsets[d] = successor(offsets[d]);
+    }
+  }
+
+  template<typename I, typename B, typename K>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             Mutable(B) && RandomAccessIterator(B) &&
+             ValueType(I) == ValueType(B) &&
+             UnaryFunction(K) && ValueType(I) == Domain(K))
+  void radix_sort_lsd_n(I f, DistanceType(I) n, B f_b, K key)
+  {
+    // Precondition: mutable_counted_range(f, n) && mutable_counted_range(f_b, n)
+    // Postcondition: the range is sorted stably by radix_key_less<K>(key)
+    // One pass counts the digits of every byte; then each byte, least
+    // significant first, is a stable scatter between the range and the
+    // buffer, skipped when all the elements have the same digit
+    typedef DistanceType(I) N;
+    typedef typename std::decay<decltype(radix_bits(key(source(f))))>::type U;
+    const int w = int(sizeof(U));
+    if (n < N(2)) return;
+    N counts[sizeof(U)][radix_digits] = {};
+    for (N i(0); i != n; i = successor(i)) {
+      U u = radix_bits(key(source(f + i)));
+      for (int b = 0; b != w; ++b) {
+        int d = int((u >> (8 * b)) & U(radix_digits - 1));
+        counts[b][d] = successor(counts[b][d]);
+      }
+    }
+    U u_f = radix_bits(key(source(f)));
+    bool in_buffer = false;
+    for (int b = 0; b != w; ++b) {
+      if (counts[b][int((u_f >> (8 * b)) & U(radix_digits - 1))] == n) continue;
+      N offsets[radix_digits];
+      N sum(0);
+      for (int d = 0; d != radix_digits; ++d) {
+        offsets[d] = sum;
+        sum = sum + counts[b][d];
+      }
+      if (in_buffer) radix_scatter_n(f_b, n, f, offsets, 8 * b, key);
+      else           radix_scatter_n(f, n, f_b, offsets, 8 * b, key);
+      in_buffer = !in_buffer;
+    }
+    if (in_buffer) eop::copy_n(f_b, n, f);
+  }
+
+  template<typename I, typename K>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             UnaryFunction(K) && ValueType(I) == Domain(K))
+  void radix_sort_msd_n_digit(I f, DistanceType(I) n, K key, int shift)
+  {
+    // Precondition: mutable_counted_range(f, n)
+    // Precondition: the elements agree on the digits above shift
+    // American flag sort (McIlroy, Bostic and McIlroy): the elements are
+    // permuted into the buckets of their digit in place, following cycles
+    // from the head of each bucket, and each bucket is then sorted by the
+    // next digit
+    typedef typename std::decay<decltype(source(f))>::type T;
+    typedef DistanceType(I) N;
+    // The counts of the first digit that splits the range place its buckets
+    N counts[radix_digits];
+    while (true) {
+      if (n < N(radix_insertion_threshold)) {
+        insertion_sort_n(f, n, radix_key_less<K>(key));
+        return;
+      }
+      for (int d = 0; d != radix_digits; ++d) counts[d] = N(0);
+      for (N i(0); i != n; i = successor(i)) {
+        int d = int((radix_bits(key(source(f + i))) >> shift) & (radix_digits - 1));
+        counts[d] = successor(counts[d]);
+      }
+      int d_f = int((radix_bits(key(source(f))) >> shift) & (radix_digits - 1));
+      if (counts[d_f] != n) break;
+      if (shift == 0) return;
+      shift = shift - 8;
+    }
+    N heads[radix_digits];
+    N tails[radix_digits];
+    N sum(0);
+    for (int d = 0; d != radix_digits; ++d) {
+      heads[d] = sum;
+      sum = sum + counts[d];
+      tails[d] = sum;
+    }
+    for (int b = 0; b != radix_digits; ++b) {
+      while (heads[b] != tails[b]) {
+        T x = source(f + heads[b]);
+        int d = int((radix_bits(key(x)) >> shift) & (radix_digits - 1));
+        while (d != b) {
+          T y = source(f + heads[d]);
+          sink(f + heads[d]) = x;
+          heads[d] = successor(heads[d]);
+          x = y;
+          d = int((radix_bits(key(x)) >> shift) & (radix_digits - 1));
+        }
+        sink(f + heads[b]) = x;
+        heads[b] = successor(heads[b]);
+      }
+    }
+    if (shift == 0) return;
+    N i(0);
+    for (int d = 0; d != radix_digits; ++d) {
+      if (N(1) < counts[d]) radix_sort_msd_n_digit(f + i, counts[d], key, shift - 8);
+      i = i + counts[d];
+    }
+  }
+
+  template<typename I, typename K>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             UnaryFunction(K) && ValueType(I) == Domain(K))
+  void radix_sort_msd_n(I f, DistanceType(I) n, K key)
+  {
+    // Precondition: mutable_counted_range(f, n)
+    // Postcondition: the range is sorted by radix_key_less<K>(key), not
+    // necessarily stably, without a buffer
+    typedef typename std::decay<decltype(radix_bits(key(source(f))))>::type U;
+    radix_sort_msd_n_digit(f, n, key, 8 * (int(sizeof(U)) - 1));
+  }
+
+  template<typename I, typename K>
+    requires(Mutable(I) && RandomAccessIterator(I) &&
+             UnaryFunction(K) && ValueType(I) == Domain(K))
+  void radix_sort_n(I f, DistanceType(I) n, K key)
+  {
+    // Precondition: mutable_counted_range(f, n)
+    // Postcondition: the range is sorted by radix_key_less<K>(key); stably
+    // when a buffer of n elements could be allocated
+    typedef typename std::decay<decltype(source(f))>::type T;
+    temporary_buffer<T> b(n);
+    if (size(b) == n) radix_sort_lsd_n(f, n, begin(b), key);
+    else              radix_sort_msd_n(f, n, key);
+  }
+
+  template<typename I>
+    requires(Mutable(I) && RandomAccessIterator(I) && Arithmetic(ValueType(I)))
+  void radix_sort_n(I f, DistanceType(I) n)
+  {
+    // Precondition: mutable_counted_range(f, n)
+    radix_sort_n(f, n, radix_identity());
+  }
+
+  template<typename I, typename K, typename S>
+    requires(ForwardLinker(S) && I == IteratorType(S) &&
+             UnaryFunction(K) && ValueType(I) == Domain(K))
+  std::pair<I, I> sort_linked_radix_n(I f, DistanceType(I) n, K key, S set_link)
+  {
+    // Precondition: counted_range(f, n)
+    // Postcondition: returns the sorted range, which ends where the
+    // counted range ended; the sort is stable
+    // Each digit distributes the nodes to the ends of radix_digits lists by
+    // relinking, which are then linked one after another, so the values are
+    // never copied
+    typedef DistanceType(I) N;
+    typedef typename std::decay<decltype(radix_bits(key(source(f))))>::type U;
+    const int w = int(sizeof(U));
+    if (n == N(0)) return std::pair<I, I>(f, f);
+    N counts[sizeof(U)][radix_digits] = {};
+    I l = f;
+    for (N i(0); i != n; i = successor(i)) {
+      U u = radix_bits(key(source(l)));
+      for (int b = 0; b != w; ++b) {
+        int d = int((u >> (8 * b)) & U(radix_digits - 1));
+        counts[b][d] = successor(counts[b][d]);
+      }
+      l = successor(l);
+    }
+    U u_f = radix_bits(key(source(f)));
+    for (int b = 0; b != w; ++b) {
+      if (counts[b][int((u_f >> (8 * b)) & U(radix_digits - 1))] == n) continue;
+      I heads[radix_digits];
+      I tails[radix_digits];
+      bool seen[radix_digits] = {};
+      I i = f;
+      for (N k(0); k != n; k = successor(k)) {
+        I j = successor(i);
+        int d = int((radix_bits(key(source(i))) >> (8 * b)) & U(radix_digits - 1));
+        if (seen[d]) set_link(tails[d], i);
+        else {
+          heads[d] = i;
+          seen[d] = true;
+        }
+        tails[d] = i;
+        i = j;
+      }
+      I t;
+      bool first = true;
+      for (int d = 0; d != radix_digits; ++d) {
+        if (!seen[d]) continue;
+        if (first) f = heads[d];
+        else       set_link(t, heads[d]);
+        t = tails[d];
+        first = false;
+      }
+      set_link(t, l);
+    }
+    return std::pair<I, I>(f, l);
+  }
+
+  // *******************************************************
+  // Prefix scans (extends Chapter 3)
+  // *******************************************************
+
+  // scan_inclusive_n writes the partial reductions of a counted range,
+  // x0, op(x0, x1), op(op(x0, x1), x2), ..., and scan_exclusive_n those
+  // before each element, z, op(z, x0), .... The output may be the input.
+  // For contiguous ranges of int or float under plus, minimum or maximum
+  // the partial reductions of four elements are formed in a register by
+  // two shifted applications of op. The parallel scans reduce a block per
+  // thread, scan the reductions and then scan the blocks from them, which
+  // needs op to be associative.
+
+  template<typename T>
+    requires(TotallyOrdered(T))
+  struct minimum {
+    typedef T first_argument_type;
+    typedef T second_argument_type;
+    typedef T result_type;
+    typedef T input_type;
+    T operator()(T a, T b) {
+      return b < a ? b : a;
+    }
+  };
+
+  template<typename T>
+    requires(TotallyOrdered(T))
+  struct maximum {
+    typedef T first_argument_type;
+    typedef T second_argument_type;
+    typedef T result_type;
+    typedef T input_type;
+    T operator()(T a, T b) {
+      return a < b ? b : a;
+    }
+  };
+
+  template<typename I, typename O, typename Op>
+    requires(Readable(I) && Iterator(I) &&
+             Writable(O) && Iterator(O) &&
+             BinaryOperation(Op) &&
+             ValueType(I) == Domain(Op) && ValueType(O) == Domain(Op))
+  O scan_inclusive_n(I f, DistanceType(I) n, O o, Op op, const Domain(Op)& z)
+  {
+    // Precondition: readable_counted_range(f, n) && writable_counted_range(o, n)
+    // Postcondition: writes op(z, x0), op(op(z, x0), x1), ...
+    Domain(Op) x = z;
+    while (!zero(n)) {
+      x = op(x, source(f));
+      sink(o) = x;
+      f = successor(f);
+      o = successor(o);
+      n = predecessor(n);
+    }
+    return o;
+  }
+
+  template<typename I, typename O, typename Op>
+    requires(Readable(I) && Iterator(I) &&
+             Writable(O) && Iterator(O) &&
+             BinaryOperation(Op) &&
+             ValueType(I) == Domain(Op) && ValueType(O) == Domain(Op))
+  O scan_exclusive_n(I f, DistanceType(I) n, O o, Op op, const Domain(Op)& z)
+  {
+    // Precondition: readable_counted_range(f, n) && writable_counted_range(o, n)
+    Domain(Op) x = z;
+    while (!zero(n)) {
+      Domain(Op) y = source(f);
+      sink(o) = x;
+      x = op(x, y);
+      f = successor(f);
+      o = successor(o);
+      n = predecessor(n);
+    }
+    return o;
+  }
+
+#if defined(__SSE2__) || defined(_M_X64)
+  template<typename T, typename Op>
+  struct scan_simd
+  {
+    typedef std::false_type vectorized;
+  };
+
+  struct scan_simd_epi32
+  {
+    // Four ints; shift_1 and shift_2 move the lanes up by one and two,
+    // filling the lanes below with the last lane of a
+    typedef std::true_type vectorized;
+    typedef int T;
+    typedef __m128i V;
+    static V load(const T* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(T* p, V x) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x); }
+    static V broadcast(T x) { return _mm_set1_epi32(x); }
+    static V last(V x) { return _mm_shuffle_epi32(x, 0xff); }
+    static V shift_1(V x, V a) { return _mm_or_si128(_mm_slli_si128(x, 4), _mm_srli_si128(last(a), 12)); }
+    static V shift_2(V x, V a) { return _mm_or_si128(_mm_slli_si128(x, 8), _mm_srli_si128(last(a), 8)); }
+  };
+
+  struct scan_simd_ps
+  {
+    typedef std::true_type vectorized;
+    typedef float T;
+    typedef __m128 V;
+    static V load(const T* p) { return _mm_loadu_ps(p); }
+    static void store(T* p, V x) { _mm_storeu_ps(p, x); }
+    static V broadcast(T x) { return _mm_set1_ps(x); }
+    static V last(V x) { return _mm_shuffle_ps(x, x, 0xff); }
+    static V shift_1(V x, V a)
+    {
+      return _mm_castsi128_ps(_mm_or_si128(_mm_slli_si128(_mm_castps_si128(x), 4),
+                                           _mm_srli_si128(_mm_castps_si128(last(a)), 12)));
+    }
+    static V shift_2(V x, V a)
+    {
+      return _mm_castsi128_ps(_mm_or_si128(_mm_slli_si128(_mm_castps_si128(x), 8),
+                                           _mm_srli_si128(_mm_castps_si128(last(a)), 8)));
+    }
+  };
+
+  template<>
+  struct scan_simd<int, plus<int>> : scan_simd_epi32
+  {
+    static V combine(V x, V y) { return _mm_add_epi32(x, y); }
+    static V identity() { return _mm_setzero_si128(); }
+  };
+
+#if defined(__SSE4_1__)
+  // Without pminsd and pmaxsd the four instructions that stand for each
+  // make the vector scan slower than the serial one
+
+  template<>
+  struct scan_simd<int, minimum<int>> : scan_simd_epi32
+  {
+    static V combine(V x, V y) { return min_epi32(x, y); }
+    static V identity() { return _mm_set1_epi32(std::numeric_limits<int>::max()); }
+  };
+
+  template<>
+  struct scan_simd<int, maximum<int>> : scan_simd_epi32
+  {
+    static V combine(V x, V y) { return max_epi32(x, y); }
+    static V identity() { return _mm_set1_epi32(std::numeric_limits<int>::min()); }
+  };
+#endif
+
+  template<>
+  struct scan_simd<float, plus<float>> : scan_simd_ps
+  {
+    static V combine(V x, V y) { return _mm_add_ps(x, y); }
+    static V identity() { return _mm_setzero_ps(); }
+  };
+
+  template<>
+  struct scan_simd<float, minimum<float>> : scan_simd_ps
+  {
+    // minps(y, x) is y < x ? y : x, which is minimum(x, y) with NaNs too
+    static V combine(V x, V y) { return _mm_min_ps(y, x); }
+    static V identity() { return _mm_set1_ps(std::numeric_limits<float>::infinity()); }
+  };
+
+  template<>
+  struct scan_simd<float, maximum<float>> : scan_simd_ps
+  {
+    static V combine(V x, V y) { return _mm_max_ps(y, x); }
+    static V identity() { return _mm_set1_ps(-std::numeric_limits<float>::infinity()); }
+  };
+
+  template<typename T, typename Op>
+    requires(BinaryOperation(Op) && T == Domain(Op))
+  pointer(T) scan_n_simd(const T* f, DistanceType(pointer(T)) n, pointer(T) o, Op op, const T& z, bool inclusive)
+  {
+    // Precondition: o == f or the ranges are disjoint
+    // c holds the reduction of the elements before the block in each lane.
+    // Two registers are scanned on their own and the second is combined
+    // with the last lane of the first, so the chain from one block to the
+    // next is one application of op and one shuffle for eight elements
+    typedef scan_simd<T, Op> S;
+    typedef typename S::V V;
+    V e = S::identity();
+    V c = S::broadcast(z);
+    DistanceType(pointer(T)) i = 0;
+    for (; i + 8 <= n; i = i + 8) {
+      V x0 = S::load(f + i);
+      V x1 = S::load(f + i + 4);
+      x0 = S::combine(S::shift_1(x0, e), x0);
+      x1 = S::combine(S::shift_1(x1, e), x1);
+      x0 = S::combine(S::shift_2(x0, e), x0);
+      x1 = S::combine(S::shift_2(x1, e), x1);
+      x1 = S::combine(S::last(x0), x1);
+      x0 = S::combine(c, x0);
+      x1 = S::combine(c, x1);
+      S::store(o + i, inclusive ? x0 : S::shift_1(x0, c));
+      S::store(o + i + 4, inclusive ? x1 : S::shift_1(x1, x0));
+      c = S::last(x1);
+    }
+    T t[4];
+    S::store(t, c);
+    if (inclusive) return eop::scan_inclusive_n(f + i, n - i, o + i, op, t[0]);
+    return eop::scan_exclusive_n(f + i, n - i, o + i, op, t[0]);
+  }
+#else
+  template<typename T, typename Op>
+  struct scan_simd
+  {
+    typedef std::false_type vectorized;
+  };
+#endif
+
+  template<typename T0, typename T1, typename Op>
+  struct scan_vectorized
+    : std::integral_constant<bool,
+        std::is_same<typename std::remove_const<T0>::type, T1>::value &&
+        scan_simd<T1, Op>::vectorized::value> {};
+
+#if defined(__SSE2__) || defined(_M_X64)
+  template<typename T0, typename T1, typename Op>
+    requires(BinaryOperation(Op) && T1 == Domain(Op))
+  pointer(T1) scan_inclusive_n_contiguous(pointer(T0) f, DistanceType(pointer(T0)) n, pointer(T1) o,
+                                          Op op, const T1& z, std::true_type)
+  {
+    return scan_n_simd(static_cast<const T1*>(f), n, o, op, z, true);
+  }
+
+  template<typename T0, typename T1, typename Op>
+    requires(BinaryOperation(Op) && T1 == Domain(Op))
+  pointer(T1) scan_exclusive_n_contiguous(pointer(T0) f, DistanceType(pointer(T0)) n, pointer(T1) o,
+                                          Op op, const T1& z, std::true_type)
+  {
+    return scan_n_simd(static_cast<const T1*>(f), n, o, op, z, false);
+  }
+#endif
+
+  template<typename T0, typename T1, typename Op>
+    requires(BinaryOperation(Op) && T1 == Domain(Op))
+  pointer(T1) scan_inclusive_n_contiguous(pointer(T0) f, DistanceType(pointer(T0)) n, pointer(T1) o,
+                                          Op op, const T1& z, std::false_type)
+  {
+    return eop::scan_inclusive_n<pointer(T0), pointer(T1), Op>(f, n, o, op, z);
+  }
+
+  template<typename T0, typename T1, typename Op>
+    requires(BinaryOperation(Op) && T1 == Domain(Op))
+  pointer(T1) scan_exclusive_n_contiguous(pointer(T0) f, DistanceType(pointer(T0)) n, pointer(T1) o,
+                                          Op op, const T1& z, std::false_type)
+  {
+    return eop::scan_exclusive_n<pointer(T0), pointer(T1), Op>(f, n, o, op, z);
+  }
+
+  template<typename T0, typename T1, typename Op>
+    requires(BinaryOperation(Op) && T1 == Domain(Op))
+  pointer(T1) scan_inclusive_n(pointer(T0) f, DistanceType(pointer(T0)) n, pointer(T1) o, Op op,
+                               const Domain(Op)& z)
+  {
+    // Precondition: o == f or the ranges are disjoint
+    return scan_inclusive_n_contiguous(f, n, o, op, z, scan_vectorized<T0, T1, Op>());
+  }
+
+  template<typename T0, typename T1, typename Op>
+    requires(BinaryOperation(Op) && T1 == Domain(Op))
+  pointer(T1) scan_exclusive_n(pointer(T0) f, DistanceType(pointer(T0)) n, pointer(T1) o, Op op,
+                               const Domain(Op)& z)
+  {
+    // Precondition: o == f or the ranges are disjoint
+    return scan_exclusive_n_contiguous(f, n, o, op, z, scan_vectorized<T0, T1, Op>());
+  }
+
+  template<typename I, typename O, typename Op>
+    requires(Readable(I) && Iterator(I) &&
+             Writable(O) && Iterator(O) &&
+             BinaryOperation(Op) &&
+             ValueType(I) == Domain(Op) && ValueType(O) == Domain(Op))
+  O scan_inclusive_n(I f, DistanceType(I) n, O o, Op op)
+  {
+    // Precondition: readable_counted_range(f, n) && writable_counted_range(o, n)
+    if (zero(n)) return o;
+    Domain(Op) x = source(f);
+    sink(o) = x;
+    return eop::scan_inclusive_n(successor(f), predecessor(n), successor(o), op, x);
+  }
+
+  // The parallel scans split the range into one block a thread; ranges
+  // of fewer than parallel_scan_min_size elements a thread are scanned by
+  // the calling thread
+
+  const int parallel_scan_min_size = 1 << 16;
+
+  template<typename I, typename Op>
+    requires(Readable(I) && RandomAccessIterator(I) &&
+             BinaryOperation(Op) && ValueType(I) == Domain(Op))
+  std::vector<Domain(Op)> reduce_blocks_parallel(I f, DistanceType(I) n, Op op, int threads)
+  {
+    // Precondition: readable_counted_range(f, n) && threads <= n
+    // Postcondition: returns the reductions of the first threads - 1 of
+    // the blocks of n / threads elements; the last block is not needed
+    typedef DistanceType(I) N;
+    // Each thread writes a separate object: the elements of a
+    // std::vector<bool> share words, so it is filled after the join
+    struct block_sum { Domain(Op) x; };
+    N b = n / N(threads);
+    std::vector<block_sum> blocks(threads - 1);
+    auto work = [&](int t) {
+      Op s = op;
+      I g = f + N(t) * b;
+      Domain(Op) x = source(g);
+      for (N i(1); i < b; i = successor(i)) x = s(x, source(g + i));
+      blocks[t].x = x;
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads - 1; ++t) pool.emplace_back(work, t);
+    if (1 < threads) work(0);
+    for (std::thread& t : pool) t.join();
+    std::vector<Domain(Op)> sums;
+    sums.reserve(blocks.size());
+    for (const block_sum& y : blocks) sums.push_back(y.x);
+    return sums;
+  }
+
+  template<typename I, typename O, typename Op>
+    requires(Readable(I) && RandomAccessIterator(I) &&
+             Writable(O) && RandomAccessIterator(O) &&
+             BinaryOperation(Op) &&
+             ValueType(I) == Domain(Op) && ValueType(O) == Domain(Op))
+  O scan_inclusive_n_parallel(I f, DistanceType(I) n, O o, Op op,
+                              int threads = default_thread_count())
+  {
+    // Precondition: readable_counted_range(f, n) && writable_counted_range(o, n)
+    // Precondition: associative(op) && 0 < threads
+    // Precondition: o == f or the ranges are disjoint
+    typedef DistanceType(I) N;
+    if (threads < 2 || n / N(threads) < N(parallel_scan_min_size))
+      return eop::scan_inclusive_n(f, n, o, op);
+    std::vector<Domain(Op)> sums = reduce_blocks_parallel(f, n, op, threads);
+    for (int t = 1; t < threads - 1; ++t) sums[t] = op(sums[t - 1], sums[t]);
+    N b = n / N(threads);
+    auto work = [&](int t) {
+      N i = N(t) * b;
+      N m = t == threads - 1 ? n - i : b;
+      Op s = op;
+      if (t == 0) eop::scan_inclusive_n(f, m, o, s);
+      else        eop::scan_inclusive_n(f + i, m, o + i, s, sums[t - 1]);
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(work, t);
+    work(0);
+    for (std::thread& t : pool) t.join();
+    return o + n;
+  }
+
+  template<typename I, typename O, typename Op>
+    requires(Readable(I) && RandomAccessIterator(I) &&
+             Writable(O) && RandomAccessIterator(O) &&
+             BinaryOperation(Op) &&
+             ValueType(I) == Domain(Op) && ValueType(O) == Domain(Op))
+  O scan_exclusive_n_parallel(I f, DistanceType(I) n, O o, Op op, const Domain(Op)& z,
+                              int threads = default_thread_count())
+  {
+    // Precondition: readable_counted_range(f, n) && writable_counted_range(o, n)
+    // Precondition: associative(op) && 0 < threads
+    // Precondition: o == f or the ranges are disjoint
+    typedef DistanceType(I) N;
+    if (threads < 2 || n / N(threads) < N(parallel_scan_min_size))
+      return eop::scan_exclusive_n(f, n, o, op, z);
+    std::vector<Domain(Op)> sums = reduce_blocks_parallel(f, n, op, threads);
+    sums.insert(sums.begin(), z);
+    for (int t = 1; t < threads; ++t) sums[t] = op(sums[t - 1], sums[t]);
+    N b = n / N(threads);
+    auto work = [&](int t) {
+      N i = N(t) * b;
+      N m = t == threads - 1 ? n - i : b;
+      Op s = op;
+      eop::scan_exclusive_n(f + i, m, o + i, s, sums[t]);
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(work, t);
+    work(0);
+    for (std::thread& t : pool) t.join();
+    return o + n;
+  }
 
 } // namespace eop
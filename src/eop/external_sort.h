@@ -0,0 +1,253 @@
+// external_sort.h
+
+// Copyright (c) 2009 Alexander Stepanov and Paul McJones
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without
+// fee, provided that the above copyright notice appear in all copies
+// and that both that copyright notice and this permission notice
+// appear in supporting documentation. The authors make no
+// representations about the suitability of this software for any
+// purpose. It is provided "as is" without express or implied
+// warranty.
+
+// Sorting files of fixed size records that do not fit in memory. The input
+// is sorted in chunks that fit the memory budget by sort_n_with_buffer, and
+// each chunk is written to a run file with one sequential write. The runs
+// are then mapped into memory and merged by merge_copy_k into the output,
+// which is written through a buffer. The pages of the mapped runs are read
+// in as the merge reaches them and can be dropped again by the system, so
+// the merge needs memory only for its output buffer.
+//
+// The functions return false when a file cannot be read or written; the
+// run files are removed in either case.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "eop.h"
+#include "intrinsics.h"
+#include "pointers.h"
+#include "type_functions.h"
+
+namespace eop {
+
+  // A mapped_file maps the whole of a file for reading. The file is closed
+  // once it is mapped, since the mapping keeps it alive, so the merge of
+  // many runs does not hold a file descriptor for each of them.
+
+  struct mapped_file
+  {
+    const char* data;
+    std::size_t size;
+#if defined(_WIN32)
+    HANDLE file;
+    HANDLE mapping;
+    mapped_file() : data(0), size(0), file(INVALID_HANDLE_VALUE), mapping(0) {}
+#else
+    int file;
+    mapped_file() : data(0), size(0), file(-1) {}
+#endif
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+    ~mapped_file() { close(); }
+
+    bool open(const char* path)
+    {
+      // Postcondition: returns whether the file was mapped; an empty file
+      // is mapped with no data
+      close();
+#if defined(_WIN32)
+      file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING,
+                         FILE_FLAG_SEQUENTIAL_SCAN, 0);
+      if (file == INVALID_HANDLE_VALUE) return false;
+      LARGE_INTEGER n;
+      if (!GetFileSizeEx(file, &n)) return false;
+      size = std::size_t(n.QuadPart);
+      if (size != 0) {
+        mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+        if (mapping == 0) return false;
+        data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (data == 0) return false;
+      }
+      close_handles();
+      return true;
+#else
+      file = ::open(path, O_RDONLY);
+      if (file < 0) return false;
+      struct stat s;
+      if (fstat(file, &s) != 0) return false;
+      size = std::size_t(s.st_size);
+      if (size != 0) {
+        void* p = mmap(0, size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (p == MAP_FAILED) return false;
+        // The merge reads each run once from front to back
+        madvise(p, size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(p);
+      }
+      close_handles();
+      return true;
+#endif
+    }
+
+    void close_handles()
+    {
+      // Postcondition: the file is closed; a mapping of it stays valid
+#if defined(_WIN32)
+      if (mapping != 0) CloseHandle(mapping);
+      if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+      mapping = 0;
+      file = INVALID_HANDLE_VALUE;
+#else
+      if (file >= 0) ::close(file);
+      file = -1;
+#endif
+    }
+
+    void close()
+    {
+#if defined(_WIN32)
+      if (data != 0) UnmapViewOfFile(data);
+#else
+      if (data != 0) munmap(const_cast<char*>(data), size);
+#endif
+      close_handles();
+      data = 0;
+      size = 0;
+    }
+  };
+
+  // A record_writer collects records in a buffer and writes it to a file
+  // when it is full; record_output_iterator writes through it
+
+  template<typename T>
+    requires(Regular(T))
+  struct record_writer
+  {
+    std::FILE* file;
+    std::vector<T> buffer;
+    std::size_t n;
+    bool good;
+    record_writer(std::FILE* file, std::size_t capacity) :
+      file(file), buffer(capacity == 0 ? 1 : capacity), n(0), good(file != 0) {}
+    void flush()
+    {
+      if (good && n != 0) good = std::fwrite(buffer.data(), sizeof(T), n, file) == n;
+      n = 0;
+    }
+  };
+
+  template<typename T>
+    requires(Regular(T))
+  struct record_output_iterator
+  {
+    typedef T value_type;
+    pointer(record_writer<T>) w;
+    T& operator*() const
+    {
+      return w->buffer[w->n];
+    }
+    record_output_iterator& operator++()
+    {
+      w->n = successor(w->n);
+      if (w->n == w->buffer.size()) w->flush();
+      return *this;
+    }
+  };
+
+  inline void remove_files(const std::vector<std::string>& paths)
+  {
+    for (const std::string& path : paths) std::remove(path.c_str());
+  }
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  bool external_sort_runs(const mapped_file& input, const std::string& prefix,
+                          std::size_t memory_bytes, R r, std::vector<std::string>& runs)
+  {
+    // Postcondition: appends to runs the names of files prefix.run0, ...,
+    // each holding a chunk of the input sorted stably by r; returns false
+    // without writing any if input.size is not a multiple of sizeof(T)
+    // The chunk and the buffer of sort_n_with_buffer, half its size, share
+    // the budget
+    static_assert(std::is_trivially_copyable<T>::value, "records are copied as bytes");
+    if (input.size % sizeof(T) != 0) return false;
+    std::size_t c = memory_bytes / sizeof(T) / 3 * 2;
+    if (c < 2) c = 2;
+    if (c > std::size_t(1) << 30) c = std::size_t(1) << 30;
+    std::vector<T> chunk(c);
+    std::vector<T> buffer(c / 2 + 1);
+    const T* f = reinterpret_cast<const T*>(input.data);
+    std::size_t n = input.size / sizeof(T);
+    while (n != 0) {
+      int m = int(n < c ? n : c);
+      copy_n(f, m, chunk.data());
+      sort_n_with_buffer(chunk.data(), m, buffer.data(), r);
+      runs.push_back(prefix + ".run" + std::to_string(runs.size()));
+      std::FILE* out = std::fopen(runs.back().c_str(), "wb");
+      if (out == 0) return false;
+      bool good = std::fwrite(chunk.data(), sizeof(T), std::size_t(m), out) == std::size_t(m);
+      if (std::fclose(out) != 0 || !good) return false;
+      f = f + m;
+      n = n - std::size_t(m);
+    }
+    return true;
+  }
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  bool external_merge_runs(const std::vector<std::string>& runs, const char* output,
+                           std::size_t memory_bytes, R r)
+  {
+    // Precondition: each run is a file of records sorted by r
+    // Postcondition: output holds the records of the runs merged stably by r
+    std::vector<mapped_file> files(runs.size());
+    typedef std::pair<const T*, const T*> Range;
+    std::vector<Range> ranges;
+    for (std::size_t i = 0; i < runs.size(); ++i) {
+      if (!files[i].open(runs[i].c_str())) return false;
+      const T* f = reinterpret_cast<const T*>(files[i].data);
+      ranges.push_back(Range(f, f + files[i].size / sizeof(T)));
+    }
+    std::FILE* out = std::fopen(output, "wb");
+    if (out == 0) return false;
+    record_writer<T> w(out, memory_bytes / sizeof(T));
+    merge_copy_k(ranges.begin(), ranges.end(), record_output_iterator<T>{ &w }, r);
+    w.flush();
+    return std::fclose(out) == 0 && w.good;
+  }
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  bool external_sort(const char* input, const char* output, std::size_t memory_bytes, R r)
+  {
+    // Precondition: output names a file other than input
+    // Postcondition: output holds the records of input sorted stably by r;
+    // the run files output.run0, ... are created next to it and removed.
+    // An input that is not a whole number of records of type T is refused
+    mapped_file in;
+    if (!in.open(input)) return false;
+    std::vector<std::string> runs;
+    bool good = external_sort_runs<T>(in, output, memory_bytes, r, runs);
+    in.close();
+    good = good && external_merge_runs<T>(runs, output, memory_bytes, r);
+    remove_files(runs);
+    return good;
+  }
+
+} // namespace eop
@@ -17,12 +17,19 @@
 #pragma once
 
 #include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "eop.h"
 #include "intrinsics.h"
 #include "pointers.h"
 
 namespace eop {
+  // Tag selecting the node constructors that build the value in place from
+  // the constructor arguments of T
+  struct emplace_t {};
+
   template<typename T>
     requires(Regular(T))
   struct slist_node 
@@ -32,7 +39,11 @@ namespace eop {
     T value;
     Link forward_link;
     slist_node() : forward_link(0) {}
-    slist_node(T value, Link s = 0) : value(value), forward_link(s) {}
+    slist_node(const T& value, Link s = 0) : value(value), forward_link(s) {}
+    slist_node(T&& value, Link s = 0) : value(std::move(value)), forward_link(s) {}
+    template<typename... Args>
+    slist_node(emplace_t, Link s, Args&&... args) :
+      value(std::forward<Args>(args)...), forward_link(s) {}
     slist_node(const slist_node& other) = default;
   };
 
@@ -197,11 +208,24 @@ namespace eop {
     typedef initializer_list_iterator<T> ILI;
     typedef slist_iterator<T> I;
     slist_node_construct() {}
-    I operator()(T x, I s = I(0)) const
+    I operator()(const T& x, I s = I(0)) const
     {
       ++slist_node_count();
       return I(new slist_node<T>(x, s.ptr));
     }
+    I operator()(T&& x, I s = I(0)) const
+    {
+      ++slist_node_count();
+      return I(new slist_node<T>(std::move(x), s.ptr));
+    }
+    template<typename... Args>
+    I emplace(I s, Args&&... args) const
+    {
+      // Postcondition: successor(result) = s
+      slist_node<T>* n = new slist_node<T>(emplace_t(), s.ptr, std::forward<Args>(args)...);
+      ++slist_node_count();
+      return I(n);
+    }
     I operator()(ILI i)    const { return (*this)(source(i)); }
     I operator()(I i)      const { return (*this)(source(i)); }
     I operator()(I i, I s) const { return (*this)(source(i), s); }
@@ -261,7 +285,7 @@ namespace eop {
     slist() : root(0) {}
 
     // from value constructor
-    slist(T x) : root(Cons()(x)) {}
+    slist(T x) : root(Cons()(std::move(x))) {}
 
     // copy constructor
     slist(const slist& x) : root(list_copy<I, I, Cons>(x.root)) {}
@@ -276,11 +300,17 @@ namespace eop {
     }
 
     // append to head
-    slist(T x, const slist& l) : root(Cons()(x)) 
+    slist(T x, const slist& l) : root(Cons()(std::move(x))) 
     {
       set_forward_link(root, list_copy<I, I, Cons>(l.root));
     }
 
+    // append to head, taking the nodes of l
+    slist(T x, slist&& l) : root(Cons()(std::move(x), l.root))
+    {
+      l.root = 0;
+    }
+
     // desctructor
     ~slist()
     {
@@ -303,20 +333,73 @@ namespace eop {
     requires(Regular(T))
   slist_iterator<T> end(slist<T> const& x)  { return slist_iterator<T>(); }
 
+  template<typename T, typename... Args>
+    requires(Regular(T))
+  slist_iterator<T> emplace_front(slist<T>& x, Args&&... args)
+  {
+    x.root = slist_node_construct<T>().emplace(x.root, std::forward<Args>(args)...);
+    return x.root;
+  }
+
+  // Builds an slist front to back, keeping the last node so each append is
+  // constant time; values are constructed in place or moved, never copied
+  template<typename T>
+    requires(Regular(T))
+  struct slist_builder
+  {
+    typedef slist_iterator<T> I;
+    I first;
+    I last;
+    // Default constructor
+    slist_builder() : first(0), last(0) {}
+    slist_builder(const slist_builder&) = delete;
+    slist_builder& operator=(const slist_builder&) = delete;
+    // Destructor
+    ~slist_builder()
+    {
+      erase_all(first);
+    }
+    template<typename... Args>
+    I emplace_back(Args&&... args)
+    {
+      I i = slist_node_construct<T>().emplace(I(0), std::forward<Args>(args)...);
+      if (empty(first)) first = i;
+      else set_forward_link(last, i);
+      last = i;
+      return i;
+    }
+    I push_back(const T& x) { return emplace_back(x); }
+    I push_back(T&& x) { return emplace_back(std::move(x)); }
+    slist<T> release()
+    {
+      // Postcondition: the builder is empty
+      slist<T> x;
+      x.root = first;
+      first = I(0);
+      last = I(0);
+      return x;
+    }
+  };
+
   // double-linked list
   template<typename T>
     requires(Regular(T))
   struct list_node
   {
     typedef T value_type;
-    typedef pointer(T) Link;
+    typedef pointer(list_node<T>) Link;
     T value;
     Link forward_link;
     Link backward_link;
     // default constructor
     list_node() : forward_link(0), backward_link(0) {}
-    list_node(T x, Link s_link = 0, Link p_link = 0) : value(x),
+    list_node(const T& x, Link s_link = 0, Link p_link = 0) : value(x),
+      forward_link(s_link), backward_link(p_link) {}
+    list_node(T&& x, Link s_link = 0, Link p_link = 0) : value(std::move(x)),
       forward_link(s_link), backward_link(p_link) {}
+    template<typename... Args>
+    list_node(emplace_t, Link s_link, Link p_link, Args&&... args) :
+      value(std::forward<Args>(args)...), forward_link(s_link), backward_link(p_link) {}
     // copy constructor
     list_node(list_node const& x) = default;
   };
@@ -395,14 +478,14 @@ namespace eop {
     requires(Regular(T))
   struct distance_type<list_iterator<T>>
   {
-    typedef T type;
+    typedef int type;
   };
 
   template<typename T>
     requires(Regular(T))
   bool empty(list_iterator<T> const& i)
   {
-    typedef pointer(slist_node<T>) I;
+    typedef pointer(list_node<T>) I;
     return i.ptr == I{0};
   }
 
@@ -455,6 +538,21 @@ namespace eop {
     bidirectional_linker<list_iterator<T>>()(c, s);
   }
 
+  template<typename T>
+    requires(Regular(T))
+  void set_forward_link(list_iterator<T> c, list_iterator<T> s)
+  {
+    forward_linker<list_iterator<T>>()(c, s);
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  void set_backward_link(list_iterator<T> p, list_iterator<T> c)
+  {
+    // Postcondition: predecessor(c) == p
+    backward_linker<list_iterator<T>>()(p, c);
+  }
+
   template<typename T>
     requires(Regular(T))
   const T& source(list_iterator<T> i)
@@ -506,4 +604,236 @@ namespace eop {
     list(list_iterator<T> r = list_iterator<T>()) : root(r) {}
   };
 
+
+  // Slab allocated doubly-linked lists
+
+  // A list_slab hands out list nodes from arrays of nodes_per_slab nodes and
+  // keeps the erased ones on a free list chained through forward_link. Lists
+  // sharing a slab can exchange nodes by relinking alone, so a splice of a
+  // whole range between them takes constant time.
+
+  template<typename T>
+    requires(Regular(T))
+  struct list_slab
+  {
+    typedef list_node<T> Node;
+    typedef list_iterator<T> I;
+    std::vector<std::unique_ptr<Node[]>> slabs;
+    pointer(Node) free_list;
+    std::size_t nodes_per_slab;
+    // Default constructor
+    // A slab holds at least one node, so grow always refills the free list
+    list_slab(std::size_t nodes_per_slab = 1024) :
+      free_list(0), nodes_per_slab(nodes_per_slab == 0 ? 1 : nodes_per_slab) {}
+    list_slab(const list_slab&) = delete;
+    list_slab& operator=(const list_slab&) = delete;
+    void grow()
+    {
+      std::unique_ptr<Node[]> slab(new Node[nodes_per_slab]);
+      for (std::size_t i = 0; i < nodes_per_slab; ++i) {
+        slab[i].forward_link = free_list;
+        free_list = &slab[i];
+      }
+      slabs.push_back(std::move(slab));
+    }
+    // The nodes of a slab are constructed with it, so allocate assigns the
+    // value to a free node rather than constructing it
+    template<typename U>
+    I allocate(U&& x)
+    {
+      if (free_list == 0) grow();
+      pointer(Node) n = free_list;
+      free_list = n->forward_link;
+      n->value = std::forward<U>(x);
+      n->forward_link = 0;
+      n->backward_link = 0;
+      return I(n);
+    }
+    void deallocate(I i)
+    {
+      sink(i.ptr).forward_link = free_list;
+      free_list = i.ptr;
+    }
+  };
+
+  // A slab_list is circular through a header node: successor(header) is the
+  // first node and predecessor(header) the last, so [begin, end) is a
+  // bounded range for the linked algorithms of Chapter 8, and no node needs
+  // a special case for being first or last.
+
+  template<typename T>
+    requires(Regular(T))
+  struct slab_list
+  {
+    typedef list_iterator<T> I;
+    pointer(list_slab<T>) slab;
+    I header;
+    // Constructor
+    explicit slab_list(list_slab<T>& s) : slab(&s), header(s.allocate(T()))
+    {
+      set_link_bidirectional(header, header);
+    }
+    slab_list(const slab_list&) = delete;
+    slab_list& operator=(const slab_list&) = delete;
+    // Destructor
+    ~slab_list()
+    {
+      I i = successor(header);
+      while (i != header) {
+        I n = successor(i);
+        slab->deallocate(i);
+        i = n;
+      }
+      slab->deallocate(header);
+    }
+  };
+
+  template<typename T>
+    requires(Regular(T))
+  struct iterator_type<slab_list<T>>
+  {
+    typedef list_iterator<T> type;
+  };
+
+  template<typename T>
+    requires(Regular(T))
+  list_iterator<T> begin(const slab_list<T>& x) { return successor(x.header); }
+
+  template<typename T>
+    requires(Regular(T))
+  list_iterator<T> end(const slab_list<T>& x) { return x.header; }
+
+  template<typename T>
+    requires(Regular(T))
+  bool empty(const slab_list<T>& x) { return begin(x) == end(x); }
+
+  template<typename T>
+    requires(Regular(T))
+  void relink_range(list_iterator<T> p, list_iterator<T> f, list_iterator<T> t, list_iterator<T> l)
+  {
+    // Precondition: the nodes from f to t are linked forward
+    // Postcondition: p, f, ..., t, l are linked both ways
+    set_link_bidirectional(p, f);
+    set_link_bidirectional(t, l);
+  }
+
+  template<typename T, typename U>
+    requires(Regular(T))
+  list_iterator<T> insert(slab_list<T>& x, list_iterator<T> pos, U&& v)
+  {
+    // Precondition: pos in [begin(x), end(x)]
+    // Postcondition: the new node precedes pos
+    list_iterator<T> i = x.slab->allocate(std::forward<U>(v));
+    relink_range(predecessor(pos), i, i, pos);
+    return i;
+  }
+
+  template<typename T, typename U>
+    requires(Regular(T))
+  list_iterator<T> push_back(slab_list<T>& x, U&& v)
+  {
+    return insert(x, end(x), std::forward<U>(v));
+  }
+
+  template<typename T, typename U>
+    requires(Regular(T))
+  list_iterator<T> push_front(slab_list<T>& x, U&& v)
+  {
+    return insert(x, begin(x), std::forward<U>(v));
+  }
+
+  template<typename T, typename... Args>
+    requires(Regular(T))
+  list_iterator<T> emplace_back(slab_list<T>& x, Args&&... args)
+  {
+    return insert(x, end(x), T(std::forward<Args>(args)...));
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  list_iterator<T> erase(slab_list<T>& x, list_iterator<T> i)
+  {
+    // Precondition: i in [begin(x), end(x))
+    list_iterator<T> n = successor(i);
+    set_link_bidirectional(predecessor(i), n);
+    x.slab->deallocate(i);
+    return n;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  void splice(list_iterator<T> pos, list_iterator<T> f, list_iterator<T> l)
+  {
+    // Precondition: f and l are in one list, l reachable from f and
+    // pos not in (f, l); the list of pos shares its slab with that list
+    // Postcondition: [f, l) is moved before pos
+    if (f == l || pos == f || pos == l) return;
+    list_iterator<T> t = predecessor(l);
+    set_link_bidirectional(predecessor(f), l);
+    relink_range(predecessor(pos), f, t, pos);
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  int size(const slab_list<T>& x)
+  {
+    int n = 0;
+    list_iterator<T> i = begin(x);
+    while (i != end(x)) {
+      n = successor(n);
+      i = successor(i);
+    }
+    return n;
+  }
+
+  template<typename T, typename P>
+    requires(Regular(T) && UnaryPredicate(P) && T == Domain(P))
+  void partition(slab_list<T>& x, P p, slab_list<T>& y)
+  {
+    // Precondition: x and y share a slab and are distinct
+    // Postcondition: the elements of x satisfying p are moved, in order, to
+    // the end of y
+    typedef list_iterator<T> I;
+    auto r = partition_linked(begin(x), end(x), p, bidirectional_linker<I>());
+    I h = x.header;
+    if (r.first.first == h) set_link_bidirectional(h, h);
+    else relink_range(h, r.first.first, r.first.second, h);
+    if (r.second.first != h)
+      relink_range(predecessor(y.header), r.second.first, r.second.second, y.header);
+  }
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  void merge(slab_list<T>& x, slab_list<T>& y, R r)
+  {
+    // Precondition: x and y share a slab and are distinct
+    // Precondition: increasing_range(begin(x), end(x), r)
+    // Precondition: increasing_range(begin(y), end(y), r)
+    // Postcondition: the elements of y are merged into x after equal ones of x
+    typedef list_iterator<T> I;
+    if (empty(y)) return;
+    if (!empty(x)) {
+      // The merged list ends at the header of y
+      std::pair<I, I> m = merge_linked_nonempty(begin(x), end(x), begin(y), end(y), r,
+                                                bidirectional_linker<I>());
+      relink_range(x.header, m.first, predecessor(y.header), x.header);
+    }
+    else relink_range(x.header, begin(y), predecessor(y.header), x.header);
+    set_link_bidirectional(y.header, y.header);
+  }
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  void sort(slab_list<T>& x, R r)
+  {
+    // Precondition: weak_ordering(r)
+    typedef list_iterator<T> I;
+    int n = size(x);
+    if (n < 2) return;
+    // Every link sort_linked_n changes is made in both directions; only the
+    // first node is left to link back to the header
+    std::pair<I, I> p = sort_linked_n(begin(x), n, r, bidirectional_linker<I>());
+    set_link_bidirectional(x.header, p.first);
+  }
+
 } // namespace eop
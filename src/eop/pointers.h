@@ -50,4 +50,10 @@ namespace eop {
   {
     typedef int type;
   };
+
+  template<typename T>
+  struct iterator_concept<pointer(T)>
+  {
+    typedef random_access_iterator_tag concept;
+  };
 }
@@ -137,4 +137,109 @@ namespace eop {
 		return count_if(c, p, WeightType(C){0});
 	}
 
+	// Ordered trees
+
+	// A tree is ordered by a weak ordering r when the values of its in-order
+	// traversal are increasing under r. A search of an ordered tree follows
+	// one path down from the root, so it takes time linear in the height of
+	// the tree rather than in its weight.
+
+	template<typename C, typename P>
+		requires(BifurcateCoordinate(C) && Readable(C) &&
+				 UnaryPredicate(P) && ValueType(C) == Domain(P))
+	C find_if_partitioned(C c, P p)
+	{
+		// Precondition: tree(c) && the in-order traversal of c is partitioned by p
+		// Postcondition: returns the first node in order satisfying p, or an
+		// empty coordinate if there is none
+		C b{ 0 };
+		if (empty(c)) return b;
+		while (true) {
+			if (p(source(c))) {
+				b = c;
+				if (!has_left_successor(c)) return b;
+				c = left_successor(c);
+			} else {
+				if (!has_right_successor(c)) return b;
+				c = right_successor(c);
+			}
+		}
+	}
+
+	template<typename C, typename R>
+		requires(BifurcateCoordinate(C) && Readable(C) &&
+				 Relation(R) && ValueType(C) == Domain(R))
+	C lower_bound_ordered(C c, const ValueType(C)& x, R r)
+	{
+		// Precondition: tree(c) && ordered(c, r)
+		// Postcondition: returns the first node in order whose value is not
+		// less than x, or an empty coordinate if there is none
+		return find_if_partitioned(c, lower_bound_predicate<R>(x, r));
+	}
+
+	template<typename C, typename R>
+		requires(BifurcateCoordinate(C) && Readable(C) &&
+				 Relation(R) && ValueType(C) == Domain(R))
+	C find_ordered(C c, const ValueType(C)& x, R r)
+	{
+		// Precondition: tree(c) && ordered(c, r)
+		// Postcondition: returns a node whose value is equivalent to x, or an
+		// empty coordinate if there is none
+		if (empty(c)) return c;
+		while (true) {
+			if (r(x, source(c))) {
+				if (!has_left_successor(c)) return C{ 0 };
+				c = left_successor(c);
+			} else if (r(source(c), x)) {
+				if (!has_right_successor(c)) return C{ 0 };
+				c = right_successor(c);
+			} else return c;
+		}
+	}
+
+	template<typename C>
+		requires(BifurcateCoordinate(C) && Readable(C) && TotallyOrdered(ValueType(C)))
+	C find_ordered(C c, const ValueType(C)& x)
+	{
+		// Precondition: tree(c) && ordered(c, less)
+		return find_ordered(c, x, less<ValueType(C)>());
+	}
+
+	// Looking up a batch of keys sorted by r in one descent visits each node
+	// once for all the keys that pass through it, rather than once for each
+	// key: the nodes near the root, where the paths of the keys meet, are
+	// read once, and the keys are split between the subtrees by binary search.
+
+	template<typename C, typename I, typename O, typename R>
+		requires(BifurcateCoordinate(C) && Readable(C) &&
+				 Readable(I) && RandomAccessIterator(I) &&
+				 Writable(O) && Iterator(O) && C == ValueType(O) &&
+				 Relation(R) && ValueType(C) == ValueType(I) == Domain(R))
+	O find_ordered_n(C c, I f, DistanceType(I) n, O o, R r)
+	{
+		// Precondition: tree(c) && ordered(c, r)
+		// Precondition: increasing_counted_range(f, n, r) && writable_counted_range(o, n)
+		// Postcondition: source(o + i) = find_ordered(c, source(f + i), r)
+		typedef DistanceType(I) N;
+		if (zero(n)) return o;
+		if (empty(c)) {
+			while (!zero(n)) {
+				sink(o) = c;
+				o = successor(o);
+				n = predecessor(n);
+			}
+			return o;
+		}
+		const ValueType(C)& x = source(c);
+		I m0 = partition_point_n(f, n, lower_bound_predicate<R>(x, r));
+		I m1 = partition_point_n(m0, n - N(m0 - f), upper_bound_predicate<R>(x, r));
+		o = find_ordered_n(has_left_successor(c) ? left_successor(c) : C{ 0 }, f, N(m0 - f), o, r);
+		while (m0 != m1) {
+			sink(o) = c;
+			o = successor(o);
+			m0 = successor(m0);
+		}
+		return find_ordered_n(has_right_successor(c) ? right_successor(c) : C{ 0 }, m1, n - N(m1 - f), o, r);
+	}
+
 } // namespace eop
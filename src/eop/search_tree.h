@@ -0,0 +1,321 @@
+// search_tree.h
+
+// Copyright (c) 2009 Alexander Stepanov and Paul McJones
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without
+// fee, provided that the above copyright notice appear in all copies
+// and that both that copyright notice and this permission notice
+// appear in supporting documentation. The authors make no
+// representations about the suitability of this software for any
+// purpose. It is provided "as is" without express or implied
+// warranty.
+
+// Balanced search trees: an ordered associative container kept as an AVL
+// tree of weighted tree coordinates, whose nodes already keep the heights
+// the balancing needs and the weights that make the k-th element a
+// logarithmic search.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "coordinate_iterator_adpater.h"
+#include "eop.h"
+#include "intrinsics.h"
+#include "tree.h"
+#include "type_functions.h"
+
+namespace eop {
+
+  // A weighted_tree_pool constructs nodes in arrays of nodes_per_slab
+  // uninitialized nodes and keeps the freed ones on a free list chained
+  // through their storage, so allocating a node takes a few instructions
+  // and the nodes of a tree stay close in memory.
+
+  template<typename T>
+    requires(Regular(T))
+  struct weighted_tree_pool
+  {
+    typedef weighted_tree_node<T> Node;
+    typedef weighted_tree_coordinate<T> C;
+    typedef typename std::aligned_storage<sizeof(Node), alignof(Node)>::type Storage;
+    std::vector<std::unique_ptr<Storage[]>> slabs;
+    pointer(Storage) free_list;
+    std::size_t nodes_per_slab;
+    // Default constructor
+    // A slab holds at least one node, so grow always refills the free list
+    weighted_tree_pool(std::size_t nodes_per_slab = 1024) :
+      free_list(0), nodes_per_slab(nodes_per_slab == 0 ? 1 : nodes_per_slab) {}
+    weighted_tree_pool(const weighted_tree_pool&) = delete;
+    weighted_tree_pool& operator=(const weighted_tree_pool&) = delete;
+    static pointer(Storage)& next(pointer(Storage) p)
+    {
+      return *reinterpret_cast<pointer(Storage)*>(p);
+    }
+    void grow()
+    {
+      std::unique_ptr<Storage[]> slab(new Storage[nodes_per_slab]);
+      for (std::size_t i = nodes_per_slab; i != 0; --i) {
+        next(&slab[i - 1]) = free_list;
+        free_list = &slab[i - 1];
+      }
+      slabs.push_back(std::move(slab));
+    }
+    C allocate(const T& x)
+    {
+      if (free_list == 0) grow();
+      pointer(Storage) p = free_list;
+      free_list = next(p);
+      return C(new (p) Node(x));
+    }
+    void deallocate(C c)
+    {
+      // Precondition: c was allocated from this pool
+      pointer(Storage) p = reinterpret_cast<pointer(Storage)>(c.ptr);
+      c.ptr->~Node();
+      next(p) = free_list;
+      free_list = p;
+    }
+  };
+
+  template<typename T>
+    requires(Regular(T))
+  struct weighted_tree_pool_deallocate
+  {
+    pointer(weighted_tree_pool<T>) pool;
+    void operator()(weighted_tree_coordinate<T> c) const
+    {
+      pool->deallocate(c);
+    }
+  };
+
+  template<typename T>
+    requires(Regular(T))
+  weighted_tree_coordinate<T> avl_rebalance(weighted_tree_coordinate<T> c)
+  {
+    // Precondition: the subtrees of c are balanced and up to date, and the
+    // heights of the successors of c and of each of its ancestors differ by
+    // at most 2
+    // Postcondition: returns the root of the tree, which is balanced and up
+    // to date
+    typedef weighted_tree_coordinate<T> C;
+    C root = c;
+    while (!empty(c)) {
+      recompute_weight_height(c);
+      int b = height(left_successor(c)) - height(right_successor(c));
+      if (1 < b) {
+        C l = left_successor(c);
+        if (height(left_successor(l)) < height(right_successor(l))) rotate_left_local(l);
+        c = rotate_right_local(c);
+      } else if (b < -1) {
+        C r = right_successor(c);
+        if (height(right_successor(r)) < height(left_successor(r))) rotate_right_local(r);
+        c = rotate_left_local(c);
+      }
+      root = c;
+      c = predecessor(c);
+    }
+    return root;
+  }
+
+  // A search_tree holds the values in increasing order under r, each at
+  // most once, so insert, erase and lower_bound take time logarithmic in
+  // its size. Iterators visit the values in order; insert and erase
+  // invalidate them, since the rotations may change the root.
+
+  template<typename T, typename R = less<T>>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  struct search_tree
+  {
+    typedef weighted_tree_coordinate<T> C;
+    typedef coordinate_iterator<C> iterator;
+    weighted_tree_pool<T> pool;
+    C root;
+    R r;
+    // Constructor
+    explicit search_tree(R r = R()) : root(0), r(r) {}
+    search_tree(const search_tree&) = delete;
+    search_tree& operator=(const search_tree&) = delete;
+    // Destructor
+    ~search_tree()
+    {
+      bifurcate_erase(root, weighted_tree_pool_deallocate<T>{ &pool });
+    }
+  };
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  bool empty(const search_tree<T, R>& x)
+  {
+    return empty(x.root);
+  }
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  int size(const search_tree<T, R>& x)
+  {
+    return weight(x.root);
+  }
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  coordinate_iterator<weighted_tree_coordinate<T>> begin(const search_tree<T, R>& x)
+  {
+    return coordinate_iterator<weighted_tree_coordinate<T>>(x.root, visit::in);
+  }
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  coordinate_iterator<weighted_tree_coordinate<T>> end(const search_tree<T, R>& x)
+  {
+    return coordinate_iterator<weighted_tree_coordinate<T>>(x.root, weighted_tree_coordinate<T>{ 0 }, visit::in);
+  }
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  coordinate_iterator<weighted_tree_coordinate<T>> iterator_at(const search_tree<T, R>& x,
+                                                               weighted_tree_coordinate<T> c)
+  {
+    // Precondition: c is a node of x or empty
+    return coordinate_iterator<weighted_tree_coordinate<T>>(x.root, c, visit::in);
+  }
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  weighted_tree_coordinate<T> lower_bound(const search_tree<T, R>& x, const T& a)
+  {
+    // Postcondition: returns the first node whose value is not less than a,
+    // or an empty coordinate if there is none
+    typedef weighted_tree_coordinate<T> C;
+    R r = x.r;
+    C c = x.root;
+    C b;
+    while (!empty(c)) {
+      if (r(source(c), a)) c = right_successor(c);
+      else {
+        b = c;
+        c = left_successor(c);
+      }
+    }
+    return b;
+  }
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  weighted_tree_coordinate<T> upper_bound(const search_tree<T, R>& x, const T& a)
+  {
+    // Postcondition: returns the first node whose value is greater than a,
+    // or an empty coordinate if there is none
+    typedef weighted_tree_coordinate<T> C;
+    R r = x.r;
+    C c = x.root;
+    C b;
+    while (!empty(c)) {
+      if (r(a, source(c))) {
+        b = c;
+        c = left_successor(c);
+      }
+      else c = right_successor(c);
+    }
+    return b;
+  }
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  weighted_tree_coordinate<T> find(const search_tree<T, R>& x, const T& a)
+  {
+    // Postcondition: returns the node whose value is equivalent to a, or an
+    // empty coordinate if there is none
+    R r = x.r;
+    weighted_tree_coordinate<T> c = lower_bound(x, a);
+    if (empty(c) || r(a, source(c))) return weighted_tree_coordinate<T>{ 0 };
+    return c;
+  }
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  weighted_tree_coordinate<T> select(const search_tree<T, R>& x, int k)
+  {
+    // Precondition: 0 <= k < size(x)
+    return in_order_select(x.root, k);
+  }
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  std::pair<weighted_tree_coordinate<T>, bool> insert(search_tree<T, R>& x, const T& a)
+  {
+    // Postcondition: returns the node holding a value equivalent to a, and
+    // whether it was inserted
+    typedef weighted_tree_coordinate<T> C;
+    typedef std::pair<C, bool> P;
+    C p;
+    C c = x.root;
+    bool left = false;
+    while (!empty(c)) {
+      p = c;
+      if (x.r(a, source(c)))      { left = true;  c = left_successor(c); }
+      else if (x.r(source(c), a)) { left = false; c = right_successor(c); }
+      else return P(c, false);
+    }
+    c = x.pool.allocate(a);
+    if (empty(p)) {
+      x.root = c;
+      return P(c, true);
+    }
+    set_predecessor(c, p);
+    if (left) set_left_successor(p, c);
+    else      set_right_successor(p, c);
+    x.root = avl_rebalance(p);
+    return P(c, true);
+  }
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  void erase(search_tree<T, R>& x, weighted_tree_coordinate<T> c)
+  {
+    // Precondition: c is a node of x
+    // The values of nodes are constant, so a node with two successors is
+    // replaced by relinking the next node in order into its place
+    typedef weighted_tree_coordinate<T> C;
+    C p = predecessor(c);
+    C start;
+    C s;
+    if (!has_left_successor(c) || !has_right_successor(c)) {
+      s = has_left_successor(c) ? left_successor(c) : right_successor(c);
+      start = p;
+    } else {
+      s = right_successor(c);
+      while (has_left_successor(s)) s = left_successor(s);
+      if (predecessor(s) == c) start = s;
+      else {
+        start = predecessor(s);
+        replace_successor(start, s, right_successor(s));
+        set_right_successor(s, right_successor(c));
+        set_predecessor(right_successor(c), s);
+      }
+      set_left_successor(s, left_successor(c));
+      set_predecessor(left_successor(c), s);
+    }
+    replace_successor(p, c, s);
+    x.root = empty(start) ? s : avl_rebalance(start);
+    x.pool.deallocate(c);
+  }
+
+  template<typename T, typename R>
+    requires(Regular(T) && Relation(R) && T == Domain(R))
+  bool erase(search_tree<T, R>& x, const T& a)
+  {
+    // Postcondition: returns whether a value equivalent to a was erased
+    weighted_tree_coordinate<T> c = find(x, a);
+    if (empty(c)) return false;
+    erase(x, c);
+    return true;
+  }
+
+} // namespace eop
@@ -0,0 +1,275 @@
+// segment_tree.h
+
+// Copyright (c) 2009 Alexander Stepanov and Paul McJones
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without
+// fee, provided that the above copyright notice appear in all copies
+// and that both that copyright notice and this permission notice
+// appear in supporting documentation. The authors make no
+// representations about the suitability of this software for any
+// purpose. It is provided "as is" without express or implied
+// warranty.
+
+// Range reductions under point updates: where reduce_nonempty_n reduces a
+// range from scratch, a segment_tree or a fenwick_tree keeps partial
+// reductions of a sequence, so the reduction of any of its ranges and the
+// change of any of its values take time logarithmic in its size. A
+// segment_tree needs only an associative operation with an identity
+// element; a fenwick_tree needs an abelian group, and keeps half as many
+// partial reductions.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "eop.h"
+#include "intrinsics.h"
+#include "type_functions.h"
+
+namespace eop {
+
+  // A segment_tree is kept bottom up in one array: the values are the
+  // leaves in [m, 2m) for m the least power of two not less than the size,
+  // padded with the identity element, and node i in [1, m) holds the
+  // reduction of its successors 2i and 2i + 1. A reduction climbs from
+  // both ends of the range to their common ancestor, combining the nodes
+  // it passes on the left and on the right separately, so the order of
+  // the values is kept and op need not be commutative.
+
+  template<typename Op>
+    requires(BinaryOperation(Op))
+  struct segment_tree
+  {
+    typedef Domain(Op) T;
+    Op op;
+    T z;
+    std::vector<T> nodes;
+    std::size_t n;
+    // Constructor
+    // Precondition: z is an identity element of op
+    // Postcondition: holds n copies of z
+    segment_tree(Op op, const T& z, std::size_t n = 0) : op(op), z(z), n(n)
+    {
+      nodes.resize(twice(segment_tree_leaves(n)), z);
+    }
+    static std::size_t segment_tree_leaves(std::size_t n)
+    {
+      std::size_t m = 1;
+      while (m < n) m = twice(m);
+      return m;
+    }
+    std::size_t leaves() const
+    {
+      return half_nonnegative(nodes.size());
+    }
+  };
+
+  template<typename Op>
+    requires(BinaryOperation(Op))
+  std::size_t size(const segment_tree<Op>& x)
+  {
+    return x.n;
+  }
+
+  template<typename I, typename Op>
+    requires(Readable(I) && Iterator(I) &&
+             BinaryOperation(Op) && ValueType(I) == Domain(Op))
+  I build_n(segment_tree<Op>& x, I f, DistanceType(I) n)
+  {
+    // Precondition: readable_counted_range(f, n)
+    // Postcondition: x holds the n values; takes linear time
+    typedef Domain(Op) T;
+    std::size_t m = segment_tree<Op>::segment_tree_leaves(std::size_t(n));
+    std::vector<T> nodes(twice(m), x.z);
+    std::size_t i = m;
+    while (i != m + std::size_t(n)) {
+      nodes[i] = source(f);
+      f = successor(f);
+      i = successor(i);
+    }
+    i = m;
+    while (i != 1) {
+      i = predecessor(i);
+      nodes[i] = x.op(nodes[twice(i)], nodes[successor(twice(i))]);
+    }
+    x.nodes.swap(nodes);
+    x.n = std::size_t(n);
+    return f;
+  }
+
+  template<typename Op>
+    requires(BinaryOperation(Op))
+  const Domain(Op)& value(const segment_tree<Op>& x, std::size_t i)
+  {
+    // Precondition: i < size(x)
+    return x.nodes[x.leaves() + i];
+  }
+
+  template<typename Op>
+    requires(BinaryOperation(Op))
+  void update(segment_tree<Op>& x, std::size_t i, const Domain(Op)& a)
+  {
+    // Precondition: i < size(x)
+    // Postcondition: value(x, i) == a
+    i = x.leaves() + i;
+    x.nodes[i] = a;
+    i = half_nonnegative(i);
+    while (i != 0) {
+      x.nodes[i] = x.op(x.nodes[twice(i)], x.nodes[successor(twice(i))]);
+      i = half_nonnegative(i);
+    }
+  }
+
+  template<typename Op>
+    requires(BinaryOperation(Op))
+  Domain(Op) reduce(const segment_tree<Op>& x, std::size_t i, std::size_t j)
+  {
+    // Precondition: i <= j <= size(x)
+    // Postcondition: returns the reduction of the values in [i, j) in
+    // order, or the identity element if the range is empty
+    typedef Domain(Op) T;
+    Op op = x.op;
+    T a = x.z;
+    T b = x.z;
+    i = x.leaves() + i;
+    j = x.leaves() + j;
+    while (i < j) {
+      // Node 0 holds the identity element, so each level combines a node
+      // on either side without a branch the values could mispredict
+      std::size_t k = i & 1;
+      std::size_t l = j & 1;
+      a = op(a, x.nodes[i & (0 - k)]);
+      b = op(x.nodes[(j - l) & (0 - l)], b);
+      i = half_nonnegative(i + k);
+      j = half_nonnegative(j - l);
+    }
+    return op(a, b);
+  }
+
+  // A fenwick_tree, or binary indexed tree, keeps in node k in [1, n] the
+  // reduction of the values in [k - l, k), for l the lowest set bit of k.
+  // A prefix of the values is the reduction of the nodes reached from its
+  // limit by clearing its lowest set bit in turn, and a value is in the
+  // nodes reached from its successor by adding its lowest set bit in turn.
+  // A range is the difference of two prefixes, so op must be commutative
+  // and inv must give its inverses.
+
+  inline std::size_t lowest_bit(std::size_t k)
+  {
+    return k & (~k + 1);
+  }
+
+  template<typename Op, typename Inv>
+    requires(BinaryOperation(Op) && UnaryFunction(Inv) &&
+             Domain(Op) == Domain(Inv) && Codomain(Inv) == Domain(Op))
+  struct fenwick_tree
+  {
+    typedef Domain(Op) T;
+    Op op;
+    Inv inv;
+    T z;
+    std::vector<T> nodes;
+    // Constructor
+    // Precondition: op is commutative, z is its identity element and
+    // inv(a) its inverse of a
+    // Postcondition: holds n copies of z
+    fenwick_tree(Op op, Inv inv, const T& z, std::size_t n = 0) :
+      op(op), inv(inv), z(z), nodes(successor(n), z) {}
+  };
+
+  template<typename Op, typename Inv>
+    requires(BinaryOperation(Op) && UnaryFunction(Inv))
+  std::size_t size(const fenwick_tree<Op, Inv>& x)
+  {
+    return predecessor(x.nodes.size());
+  }
+
+  template<typename I, typename Op, typename Inv>
+    requires(Readable(I) && Iterator(I) &&
+             BinaryOperation(Op) && UnaryFunction(Inv) &&
+             ValueType(I) == Domain(Op))
+  I build_n(fenwick_tree<Op, Inv>& x, I f, DistanceType(I) n)
+  {
+    // Precondition: readable_counted_range(f, n)
+    // Postcondition: x holds the n values; takes linear time
+    // Each node is complete when it is reached and adds itself to the one
+    // node above it
+    typedef Domain(Op) T;
+    std::vector<T> nodes(successor(std::size_t(n)), x.z);
+    std::size_t k = 1;
+    while (k != nodes.size()) {
+      nodes[k] = x.op(nodes[k], source(f));
+      std::size_t p = k + lowest_bit(k);
+      if (p < nodes.size()) nodes[p] = x.op(nodes[p], nodes[k]);
+      f = successor(f);
+      k = successor(k);
+    }
+    x.nodes.swap(nodes);
+    return f;
+  }
+
+  template<typename Op, typename Inv>
+    requires(BinaryOperation(Op) && UnaryFunction(Inv))
+  void add(fenwick_tree<Op, Inv>& x, std::size_t i, const Domain(Op)& a)
+  {
+    // Precondition: i < size(x)
+    // Postcondition: the value at i is combined with a
+    std::size_t k = successor(i);
+    while (k < x.nodes.size()) {
+      x.nodes[k] = x.op(x.nodes[k], a);
+      k = k + lowest_bit(k);
+    }
+  }
+
+  template<typename Op, typename Inv>
+    requires(BinaryOperation(Op) && UnaryFunction(Inv))
+  Domain(Op) reduce_prefix(const fenwick_tree<Op, Inv>& x, std::size_t j)
+  {
+    // Precondition: j <= size(x)
+    // Postcondition: returns the reduction of the values in [0, j)
+    typedef Domain(Op) T;
+    Op op = x.op;
+    T a = x.z;
+    while (j != 0) {
+      a = op(x.nodes[j], a);
+      j = j - lowest_bit(j);
+    }
+    return a;
+  }
+
+  template<typename Op, typename Inv>
+    requires(BinaryOperation(Op) && UnaryFunction(Inv))
+  Domain(Op) reduce(const fenwick_tree<Op, Inv>& x, std::size_t i, std::size_t j)
+  {
+    // Precondition: i <= j <= size(x)
+    // Postcondition: returns the reduction of the values in [i, j)
+    // The paths from j and from i meet at the node whose index is their
+    // common leading bits, so the nodes below it are visited once and the
+    // ones above it not at all
+    typedef Domain(Op) T;
+    Op op = x.op;
+    Inv inv = x.inv;
+    T a = x.z;
+    while (i < j) {
+      a = op(a, x.nodes[j]);
+      j = j - lowest_bit(j);
+    }
+    while (j < i) {
+      a = op(a, inv(x.nodes[i]));
+      i = i - lowest_bit(i);
+    }
+    return a;
+  }
+
+  template<typename Op, typename Inv>
+    requires(BinaryOperation(Op) && UnaryFunction(Inv))
+  void update(fenwick_tree<Op, Inv>& x, std::size_t i, const Domain(Op)& a)
+  {
+    // Precondition: i < size(x)
+    // Postcondition: the value at i is a
+    add(x, i, x.op(a, x.inv(reduce(x, i, successor(i)))));
+  }
+
+} // namespace eop
@@ -0,0 +1,167 @@
+// sliding_window.h
+
+// Copyright (c) 2009 Alexander Stepanov and Paul McJones
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without
+// fee, provided that the above copyright notice appear in all copies
+// and that both that copyright notice and this permission notice
+// appear in supporting documentation. The authors make no
+// representations about the suitability of this software for any
+// purpose. It is provided "as is" without express or implied
+// warranty.
+
+// Sliding-window aggregation: a window takes values at its back, drops
+// them from its front and keeps their reduction by an associative
+// operation, which need not be commutative or invertible. Where
+// counter_machine reduces a stream that only grows, a sliding_window
+// reduces its last values.
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "eop.h"
+#include "intrinsics.h"
+#include "type_functions.h"
+
+namespace eop {
+
+  // A sliding_window is the two-stacks lite of Tangwongsan, Hirzel and
+  // Schneider: the values are kept in order in a ring buffer, whose slots
+  // in [f, b) hold the reduction of their value and the values after it up
+  // to b, and whose slots in [b, e) hold the values themselves, reduced
+  // together in back. When a value is dropped with [f, b) empty, the slots
+  // of [b, e) are given their reductions from the back down, so each value
+  // is combined twice and push_back and pop_front take amortised constant
+  // time; that pop_front takes time linear in the size of the window.
+  // The positions count every value ever pushed and are reduced modulo the
+  // capacity, a power of two.
+
+  template<typename Op>
+    requires(BinaryOperation(Op))
+  struct sliding_window
+  {
+    typedef Domain(Op) T;
+    Op op;
+    T z;
+    std::vector<T> slots;
+    std::size_t f;
+    std::size_t b;
+    std::size_t e;
+    T back;
+    // Constructor
+    // Precondition: z is an identity element of op
+    sliding_window(Op op, const T& z, std::size_t capacity = 16) :
+      op(op), z(z), f(0), b(0), e(0), back(z)
+    {
+      std::size_t n = 1;
+      while (n < capacity) n = twice(n);
+      slots.resize(n, z);
+    }
+    std::size_t mask() const
+    {
+      return slots.size() - 1;
+    }
+  };
+
+  template<typename Op>
+    requires(BinaryOperation(Op))
+  bool empty(const sliding_window<Op>& w)
+  {
+    return w.f == w.e;
+  }
+
+  template<typename Op>
+    requires(BinaryOperation(Op))
+  std::size_t size(const sliding_window<Op>& w)
+  {
+    return w.e - w.f;
+  }
+
+  template<typename Op>
+    requires(BinaryOperation(Op))
+  Domain(Op) reduce(const sliding_window<Op>& w)
+  {
+    // Postcondition: returns the reduction of the values of the window in
+    // order, or the identity element if it is empty
+    Op op = w.op;
+    if (w.f == w.b) return w.back;
+    return op(w.slots[w.f & w.mask()], w.back);
+  }
+
+  template<typename Op>
+    requires(BinaryOperation(Op))
+  void sliding_window_grow(sliding_window<Op>& w)
+  {
+    // Postcondition: the capacity is doubled and the slots keep their
+    // positions modulo it
+    typedef Domain(Op) T;
+    std::vector<T> slots(twice(w.slots.size()), w.z);
+    std::size_t m = slots.size() - 1;
+    for (std::size_t i = w.f; i != w.e; ++i) slots[i & m] = std::move(w.slots[i & w.mask()]);
+    w.slots.swap(slots);
+  }
+
+  template<typename Op>
+    requires(BinaryOperation(Op))
+  void push_back(sliding_window<Op>& w, const Domain(Op)& x)
+  {
+    if (size(w) == w.slots.size()) sliding_window_grow(w);
+    w.slots[w.e & w.mask()] = x;
+    w.back = w.op(w.back, x);
+    w.e = successor(w.e);
+  }
+
+  template<typename Op>
+    requires(BinaryOperation(Op))
+  void sliding_window_flip(sliding_window<Op>& w)
+  {
+    // Precondition: w.f == w.b && w.b != w.e
+    // Postcondition: [f, e) holds reductions and back is the identity
+    std::size_t m = w.mask();
+    std::size_t i = predecessor(w.e);
+    while (i != w.b) {
+      i = predecessor(i);
+      w.slots[i & m] = w.op(w.slots[i & m], w.slots[successor(i) & m]);
+    }
+    w.b = w.e;
+    w.back = w.z;
+  }
+
+  template<typename Op>
+    requires(BinaryOperation(Op))
+  void pop_front(sliding_window<Op>& w)
+  {
+    // Precondition: !empty(w)
+    if (w.f == w.b) sliding_window_flip(w);
+    w.f = successor(w.f);
+  }
+
+  template<typename I, typename O, typename Op>
+    requires(Readable(I) && Iterator(I) &&
+             Writable(O) && Iterator(O) &&
+             BinaryOperation(Op) &&
+             ValueType(I) == Domain(Op) && ValueType(O) == Domain(Op))
+  O reduce_windows_n(I f, DistanceType(I) n, DistanceType(I) k, O o, Op op, const Domain(Op)& z)
+  {
+    // Precondition: readable_counted_range(f, n) && 0 < k
+    // Postcondition: writes the reductions of the windows of the last k
+    // values ending at each of the n values, the first k - 1 of them
+    // shorter
+    sliding_window<Op> w(op, z, std::size_t(k));
+    DistanceType(I) i(0);
+    while (i != n) {
+      if (i >= k) pop_front(w);
+      push_back(w, source(f));
+      sink(o) = reduce(w);
+      f = successor(f);
+      o = successor(o);
+      i = successor(i);
+    }
+    return o;
+  }
+
+} // namespace eop
@@ -633,4 +633,399 @@ namespace eop {
     return traverse(begin(x), proc);
   }
 
+  // Weighted trees
+
+  // A weighted_tree_node keeps the weight and height of the subtree it is
+  // the root of, so weight and height are constant time. Setting a successor
+  // recomputes them for the node from its successors; a change below a node
+  // already in a tree is carried to its ancestors by update_weight_height.
+  // Building a tree bottom up, as the constructors do, needs no updates.
+
+  template<typename T>
+    requires(Regular(T))
+  struct weighted_tree_node
+  {
+    typedef T value_type;
+    typedef pointer(weighted_tree_node<T>) Link;
+    const T value;
+    Link predecessor_link;
+    Link left_successor_link;
+    Link right_successor_link;
+    int weight;
+    int height;
+    constexpr weighted_tree_node(T value) : value(value), predecessor_link(0),
+      left_successor_link(0), right_successor_link(0), weight(1), height(1) {}
+    constexpr weighted_tree_node(const weighted_tree_node&) = default;
+  };
+
+  template<typename T>
+    requires(Regular(T))
+  struct weighted_tree_coordinate
+  {
+    typedef int weight_type;
+    typedef T value_type;
+    pointer(weighted_tree_node<T>) ptr;
+    constexpr weighted_tree_coordinate(pointer(weighted_tree_node<T>) ptr = 0) : ptr(ptr) {}
+  };
+
+  template<typename T>
+    requires(Regular(T))
+  struct weight_type<weighted_tree_coordinate<T>>
+  {
+    typedef int type;
+  };
+
+  template<typename T>
+    requires(Regular(T))
+  struct value_type<weighted_tree_coordinate<T>>
+  {
+    typedef T type;
+  };
+
+  template<typename T>
+    requires(Regular(T))
+  constexpr bool empty(weighted_tree_coordinate<T> c)
+  {
+    return c.ptr == 0;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  constexpr bool operator==(const weighted_tree_coordinate<T>& x, const weighted_tree_coordinate<T>& y)
+  {
+    return x.ptr == y.ptr;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  constexpr bool operator!=(const weighted_tree_coordinate<T>& x, const weighted_tree_coordinate<T>& y)
+  {
+    return !(x == y);
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  constexpr weighted_tree_coordinate<T> left_successor(weighted_tree_coordinate<T> c)
+  {
+    return source(c.ptr).left_successor_link;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  constexpr bool has_left_successor(weighted_tree_coordinate<T> c)
+  {
+    return !empty(left_successor(c));
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  constexpr weighted_tree_coordinate<T> right_successor(weighted_tree_coordinate<T> c)
+  {
+    return source(c.ptr).right_successor_link;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  constexpr bool has_right_successor(weighted_tree_coordinate<T> c)
+  {
+    return !empty(right_successor(c));
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  constexpr weighted_tree_coordinate<T> predecessor(weighted_tree_coordinate<T> c)
+  {
+    return source(c.ptr).predecessor_link;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  constexpr bool has_predecessor(weighted_tree_coordinate<T> c)
+  {
+    return !empty(predecessor(c));
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  void set_predecessor(weighted_tree_coordinate<T> c, weighted_tree_coordinate<T> p)
+  {
+    sink(c.ptr).predecessor_link = p.ptr;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  constexpr const T& source(weighted_tree_coordinate<T> c)
+  {
+    return source(c.ptr).value;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  constexpr int weight(weighted_tree_coordinate<T> c)
+  {
+    return empty(c) ? 0 : source(c.ptr).weight;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  constexpr int height(weighted_tree_coordinate<T> c)
+  {
+    return empty(c) ? 0 : source(c.ptr).height;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  bool recompute_weight_height(weighted_tree_coordinate<T> c)
+  {
+    // Precondition: !empty(c)
+    // Postcondition: returns true if the weight or height of c changed
+    int w = 1 + weight(left_successor(c)) + weight(right_successor(c));
+    int hl = height(left_successor(c));
+    int hr = height(right_successor(c));
+    int h = 1 + (hl < hr ? hr : hl);
+    weighted_tree_node<T>& n = sink(c.ptr);
+    if (n.weight == w && n.height == h) return false;
+    n.weight = w;
+    n.height = h;
+    return true;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  void update_weight_height(weighted_tree_coordinate<T> c)
+  {
+    // Precondition: the successors of c and of every node below it are up
+    // to date
+    // Postcondition: c and its ancestors are up to date; the walk stops at
+    // the first node that did not change
+    while (!empty(c) && recompute_weight_height(c)) c = predecessor(c);
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  void set_left_successor(weighted_tree_coordinate<T> c, weighted_tree_coordinate<T> l)
+  {
+    sink(c.ptr).left_successor_link = l.ptr;
+    recompute_weight_height(c);
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  void set_right_successor(weighted_tree_coordinate<T> c, weighted_tree_coordinate<T> r)
+  {
+    sink(c.ptr).right_successor_link = r.ptr;
+    recompute_weight_height(c);
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  void tree_rotate(weighted_tree_coordinate<T>& curr, weighted_tree_coordinate<T>& prev)
+  {
+    // Every node is rotated three times by traverse_rotating, which restores
+    // its successors; the weights and heights are left as they are rather
+    // than recomputed from the links in between
+    typedef weighted_tree_coordinate<T> C;
+    C tmp = left_successor(curr);
+    sink(curr.ptr).left_successor_link = right_successor(curr).ptr;
+    sink(curr.ptr).right_successor_link = prev.ptr;
+    if (empty(tmp)) { prev = tmp; return; }
+    prev = curr;
+    curr = tmp;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  void replace_successor(weighted_tree_coordinate<T> p, weighted_tree_coordinate<T> c,
+                         weighted_tree_coordinate<T> x)
+  {
+    // Precondition: c is a successor of p, or p is empty
+    // Postcondition: x takes the place of c
+    if (!empty(x)) set_predecessor(x, p);
+    if (empty(p)) return;
+    if (left_successor(p) == c) sink(p.ptr).left_successor_link = x.ptr;
+    else                        sink(p.ptr).right_successor_link = x.ptr;
+  }
+
+  // The local rotations leave the weights and heights of the ancestors as
+  // they were; a caller that recomputes every node on its way up, as
+  // avl_rebalance does, uses them rather than rotate_right and rotate_left
+
+  template<typename T>
+    requires(Regular(T))
+  weighted_tree_coordinate<T> rotate_right_local(weighted_tree_coordinate<T> c)
+  {
+    // Precondition: has_left_successor(c)
+    // Postcondition: as rotate_right, but only the weights and heights of
+    // the two nodes are exact
+    typedef weighted_tree_coordinate<T> C;
+    C p = predecessor(c);
+    C l = left_successor(c);
+    C m = right_successor(l);
+    replace_successor(p, c, l);
+    set_left_successor(c, m);
+    if (!empty(m)) set_predecessor(m, c);
+    set_right_successor(l, c);
+    set_predecessor(c, l);
+    return l;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  weighted_tree_coordinate<T> rotate_left_local(weighted_tree_coordinate<T> c)
+  {
+    // Precondition: has_right_successor(c)
+    // Postcondition: as rotate_left, but only the weights and heights of
+    // the two nodes are exact
+    typedef weighted_tree_coordinate<T> C;
+    C p = predecessor(c);
+    C r = right_successor(c);
+    C m = left_successor(r);
+    replace_successor(p, c, r);
+    set_right_successor(c, m);
+    if (!empty(m)) set_predecessor(m, c);
+    set_left_successor(r, c);
+    set_predecessor(c, r);
+    return r;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  weighted_tree_coordinate<T> rotate_right(weighted_tree_coordinate<T> c)
+  {
+    // Precondition: has_left_successor(c)
+    // Postcondition: returns the left successor of c, now in its place,
+    // with c as its right successor; the in-order traversal is unchanged
+    weighted_tree_coordinate<T> l = rotate_right_local(c);
+    update_weight_height(predecessor(l));
+    return l;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  weighted_tree_coordinate<T> rotate_left(weighted_tree_coordinate<T> c)
+  {
+    // Precondition: has_right_successor(c)
+    // Postcondition: returns the right successor of c, now in its place,
+    // with c as its left successor; the in-order traversal is unchanged
+    weighted_tree_coordinate<T> r = rotate_left_local(c);
+    update_weight_height(predecessor(r));
+    return r;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  weighted_tree_coordinate<T> in_order_select(weighted_tree_coordinate<T> c, int k)
+  {
+    // Precondition: 0 <= k < weight(c)
+    // Postcondition: returns the node of the tree c preceded by k nodes in
+    // its in-order traversal, in time linear in its height
+    while (true) {
+      int l = weight(left_successor(c));
+      if (k < l) c = left_successor(c);
+      else if (k == l) return c;
+      else {
+        k = k - l - 1;
+        c = right_successor(c);
+      }
+    }
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  int in_order_rank(weighted_tree_coordinate<T> c)
+  {
+    // Precondition: !empty(c)
+    // Postcondition: returns the number of nodes before c in the in-order
+    // traversal of the whole tree containing it
+    int k = weight(left_successor(c));
+    while (has_predecessor(c)) {
+      weighted_tree_coordinate<T> p = predecessor(c);
+      if (right_successor(p) == c) k = k + weight(left_successor(p)) + 1;
+      c = p;
+    }
+    return k;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  struct weighted_tree_node_construct
+  {
+    typedef weighted_tree_coordinate<T> C;
+    weighted_tree_node_construct() {}
+    C operator()(T x, C l = C{ 0 }, C r = C{ 0 }) const
+    {
+      C c(new weighted_tree_node<T>(x));
+      set_left_successor(c, l);
+      set_right_successor(c, r);
+      if (!empty(l)) set_predecessor(l, c);
+      if (!empty(r)) set_predecessor(r, c);
+      return c;
+    }
+    C operator()(C c, C l, C r) const { return (*this)(source(c), l, r); }
+  };
+
+  template<typename T>
+    requires(Regular(T))
+  struct weighted_tree_node_destroy
+  {
+    weighted_tree_node_destroy() = default;
+    void operator()(weighted_tree_coordinate<T> c) const
+    {
+      delete c.ptr;
+    }
+  };
+
+  template<typename T>
+    requires(Regular(T))
+  weighted_tree_coordinate<T> weighted_tree_copy(weighted_tree_coordinate<T> c)
+  {
+    // Copies bottom up, so every node is constructed with its final weight
+    if (empty(c)) return c;
+    return weighted_tree_node_construct<T>{}(c,
+      weighted_tree_copy(left_successor(c)), weighted_tree_copy(right_successor(c)));
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  struct weighted_tree
+  {
+    typedef weighted_tree_coordinate<T> C;
+    typedef weighted_tree_node_construct<T> Cons;
+    C root;
+    constexpr weighted_tree() : root(0) {}
+    weighted_tree(T value) : root(Cons{}(value)) {}
+    weighted_tree(T value, const weighted_tree& left, const weighted_tree& right) :
+      root(Cons{}(value, weighted_tree_copy(left.root), weighted_tree_copy(right.root))) {}
+    weighted_tree(const weighted_tree& x) : root(weighted_tree_copy(x.root)) {}
+    ~weighted_tree()
+    {
+      bifurcate_erase(root, weighted_tree_node_destroy<T>{});
+    }
+    void operator=(weighted_tree&& t)
+    {
+      std::swap(root, t.root);
+    }
+  };
+
+  template<typename T>
+    requires(Regular(T))
+  struct coordinate_type<weighted_tree<T>>
+  {
+    typedef weighted_tree_coordinate<T> type;
+  };
+
+  template<typename T>
+    requires(Regular(T))
+  weighted_tree_coordinate<T> begin(const weighted_tree<T>& x)
+  {
+    return x.root;
+  }
+
+  template<typename T>
+    requires(Regular(T))
+  bool empty(const weighted_tree<T>& x)
+  {
+    return empty(x.root);
+  }
+
 } // namespace eop
@@ -0,0 +1,186 @@
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+#include "gtest/gtest.h"
+#include "external_sort.h"
+
+namespace eoptest {
+	// Ordered by key; seq records the position in the input
+	struct record
+	{
+		int key;
+		int seq;
+	};
+
+	struct record_less
+	{
+		bool operator()(const record& x, const record& y) const { return x.key < y.key; }
+	};
+
+	// Input and output files in the test temporary directory, named after
+	// the test and removed with their runs when it ends
+	struct test_files
+	{
+		std::string input;
+		std::string output;
+		test_files()
+		{
+			std::string name = std::string(testing::TempDir()) + "external_sort_" +
+			                   testing::UnitTest::GetInstance()->current_test_info()->name();
+			input = name + "_input.bin";
+			output = name + "_output.bin";
+		}
+		test_files(const test_files&) = delete;
+		test_files& operator=(const test_files&) = delete;
+		~test_files()
+		{
+			std::remove(input.c_str());
+			std::remove(output.c_str());
+		}
+	};
+
+	void write_records(const std::string& path, const std::vector<record>& x)
+	{
+		std::FILE* f = std::fopen(path.c_str(), "wb");
+		ASSERT_TRUE(f != 0);
+		if (!x.empty()) {
+			EXPECT_EQ(x.size(), std::fwrite(x.data(), sizeof(record), x.size(), f));
+		}
+		std::fclose(f);
+	}
+
+	std::vector<record> read_records(const std::string& path)
+	{
+		std::vector<record> x;
+		std::FILE* f = std::fopen(path.c_str(), "rb");
+		if (f == 0) return x;
+		record r;
+		while (std::fread(&r, sizeof(record), 1, f) == 1) x.push_back(r);
+		std::fclose(f);
+		return x;
+	}
+
+	std::vector<record> random_records(int n, int keys)
+	{
+		std::mt19937 g(n);
+		std::uniform_int_distribution<int> d(0, keys - 1);
+		std::vector<record> x(n);
+		for (int i = 0; i < n; ++i) x[i] = record{ d(g), i };
+		return x;
+	}
+
+	// The output has the input's records, sorted by key and in input order
+	// among equal keys, and no run file is left behind
+	void expect_sorted(const std::vector<record>& input, const std::string& output)
+	{
+		std::vector<record> y = read_records(output);
+		ASSERT_EQ(input.size(), y.size());
+		std::vector<int> seen(input.size(), 0);
+		for (std::size_t i = 0; i < y.size(); ++i) {
+			ASSERT_TRUE(0 <= y[i].seq && std::size_t(y[i].seq) < input.size());
+			EXPECT_EQ(input[y[i].seq].key, y[i].key);
+			seen[y[i].seq] += 1;
+			if (i == 0) continue;
+			EXPECT_LE(y[i - 1].key, y[i].key);
+			if (y[i - 1].key == y[i].key) {
+				EXPECT_LT(y[i - 1].seq, y[i].seq);
+			}
+		}
+		for (int s : seen) EXPECT_EQ(1, s);
+		std::FILE* run = std::fopen((output + ".run0").c_str(), "rb");
+		EXPECT_TRUE(run == 0);
+		if (run != 0) std::fclose(run);
+	}
+
+	TEST(external_sort_tests, test_many_runs)
+	{
+		test_files t;
+		std::vector<record> x = random_records(10000, 100);
+		write_records(t.input, x);
+		// Chunks of 340 records, so 30 runs
+		EXPECT_TRUE(eop::external_sort<record>(t.input.c_str(), t.output.c_str(), 4096, record_less()));
+		expect_sorted(x, t.output);
+	}
+
+	TEST(external_sort_tests, test_more_runs_than_descriptors)
+	{
+		// Chunks of 2 records, so 600 runs merged under a limit of 64 open
+		// files; each run is closed once it is mapped
+		test_files t;
+		std::vector<record> x = random_records(1200, 1000);
+		write_records(t.input, x);
+#if !defined(_WIN32)
+		rlimit limit;
+		ASSERT_EQ(0, getrlimit(RLIMIT_NOFILE, &limit));
+		rlimit lowered = limit;
+		if (lowered.rlim_cur > 64) lowered.rlim_cur = 64;
+		ASSERT_EQ(0, setrlimit(RLIMIT_NOFILE, &lowered));
+#endif
+		bool good = eop::external_sort<record>(t.input.c_str(), t.output.c_str(), 3 * sizeof(record), record_less());
+#if !defined(_WIN32)
+		setrlimit(RLIMIT_NOFILE, &limit);
+#endif
+		EXPECT_TRUE(good);
+		expect_sorted(x, t.output);
+	}
+
+	TEST(external_sort_tests, test_one_run)
+	{
+		test_files t;
+		std::vector<record> x = random_records(1000, 1 << 20);
+		write_records(t.input, x);
+		EXPECT_TRUE(eop::external_sort<record>(t.input.c_str(), t.output.c_str(), 1 << 20, record_less()));
+		expect_sorted(x, t.output);
+	}
+
+	TEST(external_sort_tests, test_empty)
+	{
+		test_files t;
+		std::vector<record> x;
+		write_records(t.input, x);
+		EXPECT_TRUE(eop::external_sort<record>(t.input.c_str(), t.output.c_str(), 4096, record_less()));
+		expect_sorted(x, t.output);
+	}
+
+	TEST(external_sort_tests, test_partial_record)
+	{
+		// A trailing partial record is refused rather than dropped
+		test_files t;
+		write_records(t.input, random_records(10, 5));
+		std::FILE* f = std::fopen(t.input.c_str(), "ab");
+		ASSERT_TRUE(f != 0);
+		std::fputc(0, f);
+		std::fclose(f);
+		EXPECT_FALSE(eop::external_sort<record>(t.input.c_str(), t.output.c_str(), 4096, record_less()));
+		std::FILE* run = std::fopen((t.output + ".run0").c_str(), "rb");
+		EXPECT_TRUE(run == 0);
+		if (run != 0) std::fclose(run);
+	}
+
+	TEST(external_sort_tests, test_missing_input)
+	{
+		test_files t;
+		EXPECT_FALSE(eop::external_sort<record>(t.input.c_str(), t.output.c_str(), 4096, record_less()));
+	}
+
+	TEST(external_sort_tests, test_sort_n_with_buffer)
+	{
+		for (int n = 0; n < 70; ++n) {
+			std::vector<record> x = random_records(n, 5);
+			std::vector<record> b((n + 1) / 2);
+			eop::sort_n_with_buffer(x.data(), n, b.data(), record_less());
+			for (int i = 1; i < n; ++i) {
+				EXPECT_LE(x[i - 1].key, x[i].key);
+				if (x[i - 1].key == x[i].key) {
+					EXPECT_LT(x[i - 1].seq, x[i].seq);
+				}
+			}
+		}
+	}
+} // namespace eoptest
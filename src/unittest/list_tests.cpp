@@ -1,5 +1,8 @@
 
+#include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 #include "gtest/gtest.h"
 #include "intrinsics.h"
 #include "list.h"
@@ -146,4 +149,239 @@ namespace eoptest {
 		EXPECT_EQ(0, eop::slist_node_count());
 	}
 
+	// Counts the copies made of it, so tests can check that the value paths
+	// of a list move or construct in place
+	struct copy_counted
+	{
+		static int& copies() { static int n = 0; return n; }
+		int value;
+		copy_counted(int value = 0) : value(value) {}
+		copy_counted(copy_counted const& x) : value(x.value) { ++copies(); }
+		copy_counted(copy_counted&& x) : value(x.value) {}
+		copy_counted& operator=(copy_counted const& x) { value = x.value; ++copies(); return *this; }
+		copy_counted& operator=(copy_counted&& x) { value = x.value; return *this; }
+	};
+
+	TEST(slist_tests, test_slist_construct_without_copies)
+	{
+		copy_counted::copies() = 0;
+		{
+			eop::slist<copy_counted> l0(copy_counted(2));
+			eop::slist<copy_counted> l1(copy_counted(1), std::move(l0));
+			EXPECT_TRUE(eop::empty(l0.root));
+			eop::emplace_front(l1, 0);
+			EXPECT_EQ(3, eop::slist_node_count());
+			EXPECT_EQ(0, copy_counted::copies());
+			EXPECT_EQ(0, source(l1.root).value);
+			EXPECT_EQ(2, source(successor(successor(l1.root))).value);
+
+			// Copying a list copies each value exactly once
+			eop::slist<copy_counted> l2(copy_counted(-1), l1);
+			EXPECT_EQ(3, copy_counted::copies());
+		}
+		EXPECT_EQ(0, eop::slist_node_count());
+	}
+
+	TEST(slist_tests, test_slist_builder)
+	{
+		{
+			eop::slist_builder<std::string> b;
+			b.emplace_back(3, 'a');
+			b.push_back(std::string("bb"));
+			std::string c("c");
+			b.push_back(c);
+			EXPECT_EQ(3, eop::slist_node_count());
+			eop::slist<std::string> l = b.release();
+			EXPECT_TRUE(eop::empty(b.first));
+			EXPECT_EQ((std::vector<std::string>{ "aaa", "bb", "c" }), list_to_vector(l.root));
+		}
+		EXPECT_EQ(0, eop::slist_node_count());
+		{
+			// Nodes not released are erased with the builder
+			eop::slist_builder<int> b;
+			b.emplace_back(1);
+			b.emplace_back(2);
+		}
+		EXPECT_EQ(0, eop::slist_node_count());
+	}
+
+	struct less_pointee
+	{
+		bool operator()(std::unique_ptr<int> const& a, std::unique_ptr<int> const& b) const
+		{
+			return *a < *b;
+		}
+	};
+
+	struct pointee_is_odd
+	{
+		bool operator()(std::unique_ptr<int> const& a) const { return *a % 2 != 0; }
+	};
+
+	TEST(slist_tests, test_linked_algorithms_move_only)
+	{
+		typedef std::unique_ptr<int> T;
+		typedef eop::slist_iterator<T> I;
+		eop::slist_builder<T> b;
+		for (int x : { 5, 2, 7, 4, 1, 6, 3 }) b.emplace_back(new int(x));
+		eop::slist<T> l = b.release();
+
+		std::pair<I, I> p = eop::sort_linked_n(l.root, 7, less_pointee(), eop::forward_linker<I>());
+		l.root = p.first;
+		std::vector<int> v;
+		for (I i = l.root; !empty(i); i = successor(i)) v.push_back(*source(i));
+		EXPECT_EQ((std::vector<int>{ 1, 2, 3, 4, 5, 6, 7 }), v);
+
+		auto r = eop::partition_linked(l.root, I(), pointee_is_odd(), eop::forward_linker<I>());
+		eop::set_forward_link(r.first.second, I());
+		eop::set_forward_link(r.second.second, I());
+		l.root = eop::reverse_append(r.second.first, I(), r.first.first, eop::forward_linker<I>());
+		v.clear();
+		for (I i = l.root; !empty(i); i = successor(i)) v.push_back(*source(i));
+		EXPECT_EQ((std::vector<int>{ 7, 5, 3, 1, 2, 4, 6 }), v);
+	}
+
+	TEST(slab_list_tests, test_move_and_emplace)
+	{
+		copy_counted::copies() = 0;
+		eop::list_slab<copy_counted> slab;
+		eop::slab_list<copy_counted> l(slab);
+		push_back(l, copy_counted(1));
+		emplace_back(l, 2);
+		push_front(l, copy_counted(0));
+		EXPECT_EQ(0, copy_counted::copies());
+		EXPECT_EQ(3, size(l));
+		EXPECT_EQ(2, source(eop::predecessor(end(l))).value);
+	}
+
+	// Checks the list both ways, so every backward link is verified
+	template<typename T>
+	void expect_slab_list(std::vector<T> const& expected, eop::slab_list<T> const& x)
+	{
+		std::vector<T> forward;
+		for (auto i = begin(x); i != end(x); i = eop::successor(i))
+			forward.push_back(eop::source(i));
+		std::vector<T> backward;
+		for (auto i = eop::predecessor(end(x)); i != end(x); i = eop::predecessor(i))
+			backward.insert(backward.begin(), eop::source(i));
+		EXPECT_EQ(expected, forward);
+		EXPECT_EQ(expected, backward);
+	}
+
+	TEST(slab_list_tests, test_push_and_erase)
+	{
+		eop::list_slab<int> slab(4);
+		eop::slab_list<int> l(slab);
+		EXPECT_TRUE(eop::empty(l));
+		for (int i = 1; i < 6; ++i) push_back(l, i);
+		push_front(l, 0);
+		expect_slab_list({ 0, 1, 2, 3, 4, 5 }, l);
+		EXPECT_EQ(2u, slab.slabs.size());
+		auto i = erase(l, eop::successor(begin(l)));
+		EXPECT_EQ(2, eop::source(i));
+		expect_slab_list({ 0, 2, 3, 4, 5 }, l);
+		// The erased node is reused before the slab grows
+		insert(l, i, 1);
+		push_back(l, 6);
+		expect_slab_list({ 0, 1, 2, 3, 4, 5, 6 }, l);
+		EXPECT_EQ(2u, slab.slabs.size());
+		EXPECT_EQ(7, size(l));
+	}
+
+	TEST(slab_list_tests, test_empty_slab_size)
+	{
+		// A slab size of zero is taken as one node per slab
+		eop::list_slab<int> slab(0);
+		eop::slab_list<int> l(slab);
+		for (int i = 0; i < 3; ++i) push_back(l, i);
+		expect_slab_list({ 0, 1, 2 }, l);
+		EXPECT_EQ(4u, slab.slabs.size());
+	}
+
+	TEST(slab_list_tests, test_splice)
+	{
+		eop::list_slab<int> slab;
+		eop::slab_list<int> x(slab);
+		eop::slab_list<int> y(slab);
+		for (int i = 0; i < 6; ++i) push_back(x, i);
+		for (int i = 10; i < 13; ++i) push_back(y, i);
+		auto f = eop::successor(begin(x));
+		auto l = eop::successor(eop::successor(eop::successor(f)));
+		splice(eop::successor(begin(y)), f, l);
+		expect_slab_list({ 0, 4, 5 }, x);
+		expect_slab_list({ 10, 1, 2, 3, 11, 12 }, y);
+		// Moving the node to the front within a list, as an LRU cache does
+		auto last = eop::predecessor(end(y));
+		splice(begin(y), last, end(y));
+		expect_slab_list({ 12, 10, 1, 2, 3, 11 }, y);
+		splice(begin(y), begin(y), eop::successor(begin(y)));
+		expect_slab_list({ 12, 10, 1, 2, 3, 11 }, y);
+		splice(end(y), begin(x), end(x));
+		EXPECT_TRUE(eop::empty(x));
+		expect_slab_list({ 12, 10, 1, 2, 3, 11, 0, 4, 5 }, y);
+	}
+
+	struct is_odd
+	{
+		bool operator()(int x) const { return x % 2 != 0; }
+	};
+
+	TEST(slab_list_tests, test_partition)
+	{
+		eop::list_slab<int> slab;
+		eop::slab_list<int> x(slab);
+		eop::slab_list<int> y(slab);
+		push_back(y, 101);
+		for (int i : { 3, 8, 1, 4, 7, 6 }) push_back(x, i);
+		partition(x, is_odd(), y);
+		expect_slab_list({ 8, 4, 6 }, x);
+		expect_slab_list({ 101, 3, 1, 7 }, y);
+		partition(x, is_odd(), y);
+		expect_slab_list({ 8, 4, 6 }, x);
+		partition(y, is_odd(), x);
+		EXPECT_TRUE(eop::empty(y));
+		expect_slab_list({ 8, 4, 6, 101, 3, 1, 7 }, x);
+	}
+
+	TEST(slab_list_tests, test_merge)
+	{
+		eop::list_slab<int> slab;
+		eop::slab_list<int> x(slab);
+		eop::slab_list<int> y(slab);
+		for (int i : { 1, 3, 5, 7 }) push_back(x, i);
+		for (int i : { 2, 3, 4, 9, 10 }) push_back(y, i);
+		merge(x, y, std::less<int>());
+		expect_slab_list({ 1, 2, 3, 3, 4, 5, 7, 9, 10 }, x);
+		EXPECT_TRUE(eop::empty(y));
+		for (int i : { 0, 8 }) push_back(y, i);
+		merge(x, y, std::less<int>());
+		expect_slab_list({ 0, 1, 2, 3, 3, 4, 5, 7, 8, 9, 10 }, x);
+		merge(y, x, std::less<int>());
+		EXPECT_TRUE(eop::empty(x));
+		EXPECT_EQ(11, size(y));
+	}
+
+	TEST(slab_list_tests, test_sort)
+	{
+		eop::list_slab<std::string> slab(3);
+		eop::slab_list<std::string> x(slab);
+		for (auto s : { "pear", "fig", "apple", "kiwi", "date", "lime", "banana" }) push_back(x, std::string(s));
+		sort(x, std::less<std::string>());
+		expect_slab_list<std::string>({ "apple", "banana", "date", "fig", "kiwi", "lime", "pear" }, x);
+	}
+
+	TEST(slab_list_tests, test_sort_bidirectional_linked)
+	{
+		typedef eop::list_iterator<int> I;
+		eop::list_slab<int> slab;
+		eop::slab_list<int> x(slab);
+		for (int i : { 5, 2, 4, 1, 3 }) push_back(x, i);
+		// Sorts the forward links only and restores the backward links
+		// with set_backward_link
+		std::pair<I, I> p = eop::sort_bidirectioanl_linked_nonempty_n(begin(x), 5, std::less<int>());
+		EXPECT_EQ(end(x), p.second);
+		eop::set_link_bidirectional(x.header, p.first);
+		expect_slab_list({ 1, 2, 3, 4, 5 }, x);
+	}
+
 } // namespace eoptest
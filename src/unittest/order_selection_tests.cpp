@@ -2,7 +2,9 @@
 #include <cstdlib>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <list>
+#include <memory>
 #include <numeric>
 #include <string>
 #include <sstream>
@@ -1487,6 +1489,49 @@ namespace eoptest
                 EXPECT_EQ(3, source(r));
         }
 
+        struct collect_visits
+        {
+                vector<int>* r;
+                eop::visit order;
+                void operator()(eop::visit v, Coordinate x)
+                {
+                        if (v == order) r->push_back(source(x));
+                }
+        };
+
+        vector<int> traversal_order(Coordinate c, eop::visit order)
+        {
+                vector<int> r;
+                eop::traverse_nonempty(c, collect_visits{ &r, order });
+                return r;
+        }
+
+        TEST(project_7_2_tests, test_iterator_all_orders)
+        {
+                Tree t = create_medium_tree();
+                // The right subtree of 1 is iterated on its own, without
+                // continuing into the rest of the tree
+                Coordinate subtree = eop::right_successor(eop::left_successor(begin(t)));
+                for (Coordinate root : { begin(t), subtree }) {
+                        for (eop::visit order : { eop::visit::pre, eop::visit::in, eop::visit::post }) {
+                                vector<int> actual(begin(root, order), end(root, order));
+                                EXPECT_EQ(traversal_order(root, order), actual);
+                                EXPECT_EQ(std::accumulate(begin(actual), end(actual), 0),
+                                          std::accumulate(begin(root, order), end(root, order), 0));
+                        }
+                }
+        }
+
+        TEST(project_7_2_tests, test_iterator_reference)
+        {
+                Tree t = create_tree();
+                Coordinate c = begin(t);
+                auto i = begin(c, eop::visit::pre);
+                EXPECT_EQ(&source(c), &*i);
+                ++i;
+                EXPECT_EQ(&source(eop::left_successor(c)), &source(i));
+        }
+
         TEST(bifurcate_isomorphic_tests, test_bifurcate_isomorphic_nonempty)
         {
                 Tree t0{ 0 };
@@ -1540,6 +1585,91 @@ namespace eoptest
                 EXPECT_FALSE(eop::lexicographical_equal(begin(v0), end(v0), begin(v3), end(v3)));
         }
 
+        TEST(lexicographical_compare_test, test_find_mismatch_contiguous)
+        {
+                // Every position of the mismatch, across the vector and word loops
+                for (int n = 0; n < 80; ++n) {
+                        for (int k = 0; k <= n; ++k) {
+                                vector<unsigned char> b0(n, 7);
+                                vector<unsigned char> b1(n, 7);
+                                vector<int> i0(n, -7);
+                                vector<int> i1(n, -7);
+                                if (k < n) {
+                                        b1[k] = 8;
+                                        i1[k] = 1 << 30;
+                                }
+                                const unsigned char* f0 = b0.data();
+                                auto rb = eop::find_mismatch(f0, f0 + n, b1.data(), b1.data() + n, eop::equal<unsigned char>());
+                                EXPECT_EQ(f0 + k, rb.first);
+                                EXPECT_EQ(b1.data() + k, rb.second);
+                                auto ri = eop::find_mismatch(i0.data(), i0.data() + n, i1.data(), i1.data() + n, std::equal_to<int>());
+                                EXPECT_EQ(i0.data() + k, ri.first);
+                                EXPECT_EQ(i1.data() + k, ri.second);
+                        }
+                }
+                // Different lengths stop at the shorter
+                int x[] = { 1, 2, 3 };
+                int y[] = { 1, 2 };
+                EXPECT_EQ(x + 2, eop::find_mismatch(x, x + 3, y, y + 2, eop::equal<int>()).first);
+                // Other relations keep the element by element comparison
+                double d0[] = { 0.0, 1.0 };
+                double d1[] = { -0.0, 2.0 };
+                EXPECT_EQ(d0 + 1, eop::find_mismatch(d0, d0 + 2, d1, d1 + 2, eop::equal<double>()).first);
+        }
+
+        TEST(lexicographical_compare_test, test_lexicographical_compare_contiguous)
+        {
+                unsigned char a[] = { 1, 2, 200 };
+                unsigned char b[] = { 1, 2, 3, 4 };
+                eop::less<unsigned char> lb;
+                EXPECT_FALSE(eop::lexicographical_compare(a, a + 3, b, b + 4, lb));
+                EXPECT_TRUE(eop::lexicographical_compare(b, b + 4, a, a + 3, lb));
+                EXPECT_TRUE(eop::lexicographical_compare(a, a + 2, a, a + 3, lb));
+                EXPECT_FALSE(eop::lexicographical_compare(a, a + 3, a, a + 3, lb));
+                EXPECT_FALSE(eop::lexicographical_compare(a, a, b, b, lb));
+
+                // Signed values are not ordered by their bytes
+                int i[] = { 5, -1, 0 };
+                int j[] = { 5, 1 };
+                EXPECT_TRUE(eop::lexicographical_compare(i, i + 3, j, j + 2, eop::less<int>()));
+                EXPECT_FALSE(eop::lexicographical_compare(j, j + 2, i, i + 3, std::less<int>()));
+                EXPECT_TRUE(eop::lexicographical_less(i, i + 3, j, j + 2));
+                EXPECT_TRUE(eop::lexicographical_compare(j, j + 2, i, i + 3, std::greater<int>()));
+
+                EXPECT_TRUE(eop::lexicographical_equal(i, i + 2, i, i + 2));
+                EXPECT_FALSE(eop::lexicographical_equal(i, i + 2, j, j + 2));
+                EXPECT_FALSE(eop::lexicographical_equal(i, i + 1, j, j + 2));
+                EXPECT_TRUE(eop::lexicographical_equal(i, i, j, j));
+
+                vector<int> v0{ 1, 2, 3 };
+                vector<int> v1{ 1, 3 };
+                EXPECT_TRUE(eop::lexicographical_less(begin(v0), end(v0), begin(v1), end(v1)));
+        }
+
+        TEST(lexicographical_compare_test, test_lexicographical_compare_parallel)
+        {
+                // Several blocks of parallel_compare_block_bytes
+                int n = int(3 * eop::parallel_compare_block_bytes / sizeof(int) + 5);
+                vector<int> v0(n);
+                for (int i = 0; i < n; ++i) v0[i] = i;
+                vector<int> v1 = v0;
+                EXPECT_TRUE(eop::lexicographical_equal_parallel(v0.data(), v0.data() + n, v1.data(), v1.data() + n, 4));
+                EXPECT_FALSE(eop::lexicographical_less_parallel(v0.data(), v0.data() + n, v1.data(), v1.data() + n, 4));
+                EXPECT_TRUE(eop::lexicographical_less_parallel(v0.data(), v0.data() + n - 1, v1.data(), v1.data() + n, 4));
+                for (int k : { 0, n / 3, n / 2, n - 1 }) {
+                        v1[k] = -1;
+                        // Later mismatches don't hide the first
+                        if (k + 1 < n) v1[n - 1] = -1;
+                        auto r = eop::find_mismatch_parallel(begin(v0), end(v0), begin(v1), end(v1), std::equal_to<int>(), 4);
+                        EXPECT_EQ(k, r.first - begin(v0));
+                        EXPECT_FALSE(eop::lexicographical_equal_parallel(begin(v0), end(v0), begin(v1), end(v1), 3));
+                        EXPECT_TRUE(eop::lexicographical_less_parallel(v1.data(), v1.data() + n, v0.data(), v0.data() + n, 4));
+                        EXPECT_FALSE(eop::lexicographical_compare_parallel(begin(v0), end(v0), begin(v1), end(v1), eop::less<int>(), 4));
+                        EXPECT_TRUE(eop::lexicographical_compare_parallel(begin(v0), end(v0), begin(v1), end(v1), std::greater<int>(), 2));
+                        v1 = v0;
+                }
+        }
+
         TEST(bifurcate_equivalent_tests, test_bifurcate_equal_nonempty)
         {
                 STree t0 = STree{ 3, 
@@ -1659,6 +1789,132 @@ namespace eoptest
         // Chapter 8 Coordinates with Mutable Successors
         //
 
+        // A complete tree over [f, l) in order; the value changed_key, if
+        // present, is replaced by changed_value
+        Tree create_balanced_tree(int f, int l, int changed_key = -1, int changed_value = 0)
+        {
+                if (f == l) return Tree{};
+                int m = f + (l - f) / 2;
+                int v = m == changed_key ? changed_value : m;
+                return Tree{ v, create_balanced_tree(f, m, changed_key, changed_value),
+                        create_balanced_tree(m + 1, l, changed_key, changed_value) };
+        }
+
+        TEST(bifurcate_parallel_tests, test_bifurcate_equal_nonempty_parallel)
+        {
+                Tree t0 = create_balanced_tree(0, 1000);
+                Tree t1 = create_balanced_tree(0, 1000);
+                for (int threads : { 1, 2, 4 }) {
+                        EXPECT_TRUE(eop::bifurcate_equal_nonempty_parallel(begin(t0), begin(t1), threads));
+                        EXPECT_TRUE(eop::bifurcate_isomorphic_nonempty_parallel(begin(t0), begin(t1), threads));
+                        // Above, at and below the split depth
+                        for (int key : { 500, 3, 997, 0, 999 }) {
+                                Tree t2 = create_balanced_tree(0, 1000, key, -1);
+                                EXPECT_FALSE(eop::bifurcate_equal_nonempty_parallel(begin(t0), begin(t2), threads));
+                                EXPECT_TRUE(eop::bifurcate_isomorphic_nonempty_parallel(begin(t0), begin(t2), threads));
+                        }
+                }
+                Tree t3 = create_balanced_tree(0, 999);
+                EXPECT_FALSE(eop::bifurcate_equal_nonempty_parallel(begin(t0), begin(t3), 4));
+                EXPECT_FALSE(eop::bifurcate_isomorphic_nonempty_parallel(begin(t0), begin(t3), 4));
+        }
+
+        TEST(bifurcate_parallel_tests, test_bifurcate_less_nonempty_parallel)
+        {
+                Tree t0 = create_balanced_tree(0, 1000);
+                // The first difference in preorder decides, whatever follows it
+                Tree t1 = create_balanced_tree(0, 1000, 3, 1000);
+                Tree t2 = create_balanced_tree(0, 1000, 997, -1);
+                Tree t3 = create_balanced_tree(0, 1001);
+                for (int threads : { 1, 2, 4, 16 }) {
+                        EXPECT_FALSE(eop::bifurcate_less_nonempty_parallel(begin(t0), begin(t0), threads));
+                        for (Tree const* x : { &t0, &t1, &t2, &t3 })
+                                for (Tree const* y : { &t0, &t1, &t2, &t3 })
+                                        EXPECT_EQ(eop::bifurcate_less_nonempty(begin(*x), begin(*y)),
+                                                  eop::bifurcate_less_nonempty_parallel(begin(*x), begin(*y), threads));
+                }
+        }
+
+        TEST(bifurcate_parallel_tests, test_bifurcate_merkle_hashes)
+        {
+                Tree t0 = create_balanced_tree(0, 100);
+                Tree t1 = create_balanced_tree(0, 100);
+                auto h0 = eop::bifurcate_merkle_hashes(begin(t0));
+                auto h1 = eop::bifurcate_merkle_hashes(begin(t1));
+                ASSERT_EQ(100u, h0.size());
+                EXPECT_EQ(100, h0[0].weight);
+                EXPECT_EQ(h0[0].hash, h1[0].hash);
+                EXPECT_TRUE(eop::bifurcate_equal_hashed(begin(t0), h0, begin(t1), h1, 2));
+                auto m = eop::bifurcate_mismatch_hashed(begin(t0), h0, begin(t1), h1);
+                EXPECT_TRUE(eop::empty(m.first) && eop::empty(m.second));
+
+                for (int key : { 50, 0, 37, 99 }) {
+                        Tree t2 = create_balanced_tree(0, 100, key, -1);
+                        auto h2 = eop::bifurcate_merkle_hashes(begin(t2));
+                        EXPECT_NE(h0[0].hash, h2[0].hash);
+                        EXPECT_FALSE(eop::bifurcate_equal_hashed(begin(t0), h0, begin(t2), h2, 2));
+                        m = eop::bifurcate_mismatch_hashed(begin(t0), h0, begin(t2), h2);
+                        ASSERT_FALSE(eop::empty(m.first));
+                        EXPECT_EQ(key, source(m.first));
+                        EXPECT_EQ(-1, source(m.second));
+                }
+
+                // Same values, different shape
+                Tree t3{ 1, Tree{ 2 }, Tree{} };
+                Tree t4{ 1, Tree{}, Tree{ 2 } };
+                auto h3 = eop::bifurcate_merkle_hashes(begin(t3));
+                auto h4 = eop::bifurcate_merkle_hashes(begin(t4));
+                EXPECT_NE(h3[0].hash, h4[0].hash);
+                m = eop::bifurcate_mismatch_hashed(begin(t3), h3, begin(t4), h4);
+                EXPECT_EQ(begin(t3), m.first);
+                EXPECT_TRUE(eop::bifurcate_merkle_hashes(begin(Tree{})).empty());
+        }
+
+        TEST(project_7_1_tests, test_find_ordered)
+        {
+                // 0, ..., 49, 51, 51, 52, ..., 99
+                Tree t = create_balanced_tree(0, 100, 50, 51);
+                Tree e;
+                for (int i : { 0, 17, 49, 51, 52, 99 }) EXPECT_EQ(i, source(eop::find_ordered(begin(t), i)));
+                EXPECT_TRUE(eop::empty(eop::find_ordered(begin(t), 50)));
+                EXPECT_TRUE(eop::empty(eop::find_ordered(begin(t), -1)));
+                EXPECT_TRUE(eop::empty(eop::find_ordered(begin(t), 100)));
+                EXPECT_TRUE(eop::empty(eop::find_ordered(begin(e), 1)));
+        }
+
+        TEST(project_7_1_tests, test_lower_bound_ordered)
+        {
+                Tree t = create_balanced_tree(0, 100, 50, 51);
+                eop::less<int> lt;
+                EXPECT_EQ(0, source(eop::lower_bound_ordered(begin(t), -5, lt)));
+                EXPECT_EQ(49, source(eop::lower_bound_ordered(begin(t), 49, lt)));
+                // The first of the two nodes holding 51 in order is the one
+                // that held 50
+                Coordinate c = eop::lower_bound_ordered(begin(t), 50, lt);
+                EXPECT_EQ(51, source(c));
+                EXPECT_EQ(c, eop::lower_bound_ordered(begin(t), 51, lt));
+                EXPECT_EQ(c, eop::find_if_partitioned(begin(t), [](int x) { return 50 <= x; }));
+                EXPECT_TRUE(eop::empty(eop::lower_bound_ordered(begin(t), 100, lt)));
+                EXPECT_TRUE(eop::empty(eop::find_if_partitioned(begin(t), [](int) { return false; })));
+        }
+
+        TEST(project_7_1_tests, test_find_ordered_n)
+        {
+                Tree t = create_balanced_tree(0, 1000, 500, 501);
+                std::vector<int> keys;
+                for (int i = -3; i < 1004; i += 3) keys.push_back(i);
+                keys.push_back(1004);
+                keys.push_back(1004);
+                std::vector<Coordinate> found(keys.size());
+                auto o = eop::find_ordered_n(begin(t), keys.data(), (std::ptrdiff_t)keys.size(), found.data(), eop::less<int>());
+                EXPECT_EQ(found.data() + found.size(), o);
+                for (std::size_t i = 0; i < keys.size(); ++i)
+                        EXPECT_EQ(eop::find_ordered(begin(t), keys[i]), found[i]);
+                Tree e;
+                eop::find_ordered_n(begin(e), keys.data(), (std::ptrdiff_t)keys.size(), found.data(), eop::less<int>());
+                for (Coordinate c : found) EXPECT_TRUE(eop::empty(c));
+        }
+
         // 8.2 Link Rearrangements
 
         template<typename I>
@@ -2082,6 +2338,70 @@ namespace eoptest
     EXPECT_EQ(expected_z, z);
   }
 
+  template<typename T>
+  void check_compaction(int n, int percent)
+  {
+    // Compares the contiguous compaction with element by element copying,
+    // for every length up to n
+    vector<T> x(n);
+    unsigned r = 7u + unsigned(percent);
+    for (T& a : x) {
+      r = r * 1103515245u + 12345u;
+      a = T((r >> 16) % 100u);
+    }
+    auto p = [percent](T a) { return a < T(percent); };
+    for (int m = 0; m <= n; ++m) {
+      vector<T> expected_t, expected_f;
+      for (int i = 0; i < m; ++i) (p(x[i]) ? expected_t : expected_f).push_back(x[i]);
+
+      vector<T> t(m), f(m);
+      T* l_t = eop::copy_if(x.data(), x.data() + m, t.data(), p);
+      EXPECT_EQ(expected_t, vector<T>(t.data(), l_t)) << m;
+
+      std::pair<T*, T*> l = eop::partition_copy_n(x.data(), m, f.data(), t.data(), p);
+      EXPECT_EQ(expected_f, vector<T>(f.data(), l.first)) << m;
+      EXPECT_EQ(expected_t, vector<T>(t.data(), l.second)) << m;
+
+      // The blocks, whether or not copy_if and partition_copy_n take them
+      eop::predicate_source<T*, decltype(p)> ps(p);
+      l_t = eop::copy_select_blocked(x.data(), x.data() + m, t.data(), ps);
+      EXPECT_EQ(expected_t, vector<T>(t.data(), l_t)) << m;
+      l = eop::split_copy_n_blocked(x.data(), m, f.data(), t.data(), ps);
+      EXPECT_EQ(expected_f, vector<T>(f.data(), l.first)) << m;
+      EXPECT_EQ(expected_t, vector<T>(t.data(), l.second)) << m;
+
+      // The false elements may be written over the input
+      vector<T> y(x.begin(), x.begin() + m);
+      l = eop::partition_copy(y.data(), y.data() + m, y.data(), t.data(), p);
+      EXPECT_EQ(expected_f, vector<T>(y.data(), l.first)) << m;
+      EXPECT_EQ(expected_t, vector<T>(t.data(), l.second)) << m;
+    }
+  }
+
+  TEST(chapter_9_copying, test_copy_if_contiguous)
+  {
+    for (int percent : { 0, 1, 50, 99, 100 }) {
+      check_compaction<int>(600, percent);
+      check_compaction<double>(600, percent);
+      check_compaction<unsigned char>(600, percent);
+      check_compaction<short>(600, percent);
+    }
+  }
+
+  TEST(chapter_9_copying, test_copy_select_contiguous)
+  {
+    vector<int> x = {1, 2, 3, 4, 5};
+    vector<int> y(5);
+    int* l = eop::copy_select(x.data(), x.data() + x.size(), y.data(), is_even_iterator<int*>());
+    EXPECT_EQ(vector<int>({2, 4}), vector<int>(y.data(), l));
+
+    vector<int> f(5), t(5);
+    std::pair<int*, int*> r = eop::split_copy(x.data(), x.data() + x.size(), f.data(), t.data(),
+                                              is_even_iterator<int*>());
+    EXPECT_EQ(vector<int>({1, 3, 5}), vector<int>(f.data(), r.first));
+    EXPECT_EQ(vector<int>({2, 4}), vector<int>(t.data(), r.second));
+  }
+
   TEST(chapter_9_copying, test_merge_copy)
   {
     vector<int> y{1, 3, 7, 8};
@@ -2106,6 +2426,63 @@ namespace eoptest
     EXPECT_EQ(end(z), std::get<1>(result));
   }
 
+  TEST(chapter_9_copying, test_merge_copy_n_contiguous)
+  {
+    // Keys equivalent under r when they have the same tens, so the order
+    // of equivalent elements in the output shows that the merge is stable
+    auto r = [](int a, int b) { return a / 10 < b / 10; };
+    for (int n0 = 0; n0 < 24; ++n0) {
+      for (int n1 = 0; n1 < 24; ++n1) {
+        vector<int> x(n0), y(n1);
+        for (int i = 0; i < n0; ++i) x[i] = (i * 7 / 3) * 10 + 1;
+        for (int i = 0; i < n1; ++i) y[i] = (i * 5 / 2) * 10 + 2;
+        vector<int> expected;
+        eop::merge_copy_n(begin(x), n0, begin(y), n1, back_inserter(expected), r);
+
+        vector<int> z(n0 + n1);
+        auto l = eop::merge_copy_n(x.data(), n0, y.data(), n1, z.data(), r);
+        EXPECT_EQ(expected, z) << n0 << " " << n1;
+        EXPECT_EQ(x.data() + n0, std::get<0>(l));
+        EXPECT_EQ(y.data() + n1, std::get<1>(l));
+        EXPECT_EQ(z.data() + n0 + n1, std::get<2>(l));
+
+        vector<int> w(n0 + n1);
+        int* l_w = eop::merge_copy(x.data(), x.data() + n0, y.data(), y.data() + n1, w.data(), r);
+        EXPECT_EQ(expected, w) << n0 << " " << n1;
+        EXPECT_EQ(w.data() + n0 + n1, l_w);
+
+        vector<int> v(n0 + n1);
+        auto l_v = eop::merge_copy_n_branchless(x.data(), n0, y.data(), n1, v.data(), r);
+        EXPECT_EQ(expected, v) << n0 << " " << n1;
+        EXPECT_EQ(x.data() + n0, std::get<0>(l_v));
+        EXPECT_EQ(y.data() + n1, std::get<1>(l_v));
+        EXPECT_EQ(v.data() + n0 + n1, std::get<2>(l_v));
+      }
+    }
+  }
+
+#if defined(__SSE2__) || defined(_M_X64)
+  TEST(chapter_9_copying, test_merge_copy_n_bitonic)
+  {
+    for (int n0 = 0; n0 < 40; ++n0) {
+      for (int n1 = 0; n1 < 40; ++n1) {
+        vector<int> x(n0), y(n1);
+        for (int i = 0; i < n0; ++i) x[i] = i * 3 - (i % 7 == 0 ? 1 : 0) - 20;
+        for (int i = 0; i < n1; ++i) y[i] = i * 2 + (n0 % 3) - 30;
+        vector<int> expected;
+        eop::merge_copy_n(begin(x), n0, begin(y), n1, back_inserter(expected), eop::less<int>());
+
+        vector<int> z(n0 + n1);
+        auto l = eop::merge_copy_n_bitonic(x.data(), n0, y.data(), n1, z.data());
+        EXPECT_EQ(expected, z) << n0 << " " << n1;
+        EXPECT_EQ(x.data() + n0, std::get<0>(l));
+        EXPECT_EQ(y.data() + n1, std::get<1>(l));
+        EXPECT_EQ(z.data() + n0 + n1, std::get<2>(l));
+      }
+    }
+  }
+#endif
+
   TEST(chapter_9_copying, test_merge_copy_backward_n)
   {
     vector<int> y{8, 7, 3, 1};
@@ -2132,6 +2509,63 @@ namespace eoptest
     EXPECT_EQ(begin(r), std::get<2>(result));
   }
 
+  TEST(chapter_9_copying, test_merge_copy_k)
+  {
+    typedef vector<int>::const_iterator I;
+    for (int k = 0; k < 12; ++k) {
+      vector<vector<int>> runs(k);
+      vector<int> expected_r;
+      for (int i = 0; i < k; ++i) {
+        // Runs of different lengths, some empty
+        for (int j = 0; j < (i * 7) % 5; ++j) runs[i].push_back(3 * j + i % 4);
+      }
+      // Every value in [0, 16) as often as it appears in the runs
+      for (int v = 0; v < 16; ++v)
+        for (const vector<int>& run : runs)
+          for (int x : run)
+            if (x == v) expected_r.push_back(v);
+      vector<std::pair<I, I>> ranges;
+      for (const vector<int>& run : runs) ranges.push_back(std::make_pair(run.cbegin(), run.cend()));
+      vector<int> r;
+      eop::merge_copy_k(begin(ranges), end(ranges), back_inserter(r), std::less<int>());
+      EXPECT_EQ(expected_r, r);
+    }
+  }
+
+  TEST(chapter_9_copying, test_merge_copy_k_stable)
+  {
+    // Equivalent under the first element; the second records the range
+    typedef std::pair<int, int> P;
+    vector<vector<P>> runs{ { P(1, 0), P(2, 0), P(2, 0) },
+                            { P(0, 1), P(2, 1) },
+                            {},
+                            { P(1, 3), P(2, 3), P(3, 3) },
+                            { P(2, 4) } };
+    typedef vector<P>::iterator I;
+    vector<std::pair<I, I>> ranges;
+    for (vector<P>& run : runs) ranges.push_back(std::make_pair(begin(run), end(run)));
+    vector<P> r(9);
+    auto l = eop::merge_copy_k(begin(ranges), end(ranges), begin(r),
+                               [](const P& x, const P& y) { return x.first < y.first; });
+    EXPECT_EQ(end(r), l);
+    vector<P> expected_r{ P(0, 1), P(1, 0), P(1, 3), P(2, 0), P(2, 0),
+                          P(2, 1), P(2, 3), P(2, 4), P(3, 3) };
+    EXPECT_EQ(expected_r, r);
+  }
+
+  TEST(chapter_9_copying, test_merge_copy_k_by_iterator)
+  {
+    // Heads of strings are kept as iterators rather than copies
+    vector<vector<std::string>> runs{ { "b", "d", "f" }, {}, { "a", "d", "g" }, { "c", "e" } };
+    typedef vector<std::string>::const_iterator I;
+    vector<std::pair<I, I>> ranges;
+    for (const vector<std::string>& run : runs) ranges.push_back(std::make_pair(run.cbegin(), run.cend()));
+    vector<std::string> r;
+    eop::merge_copy_k(begin(ranges), end(ranges), back_inserter(r), std::less<std::string>());
+    vector<std::string> expected_r{ "a", "b", "c", "d", "d", "e", "f", "g" };
+    EXPECT_EQ(expected_r, r);
+  }
+
   TEST(chapter_9_4_swap_ranges, test_swap_ranges_empty)
   {
     vector<int> x, y;
@@ -2656,6 +3090,44 @@ namespace eoptest
     EXPECT_TRUE(eop::partitioned_at_point(begin(v4), m4, end(v4), eop::is_Even<int>())) << "Not partitioned at the returned iterator";
   }
   
+  TEST(chapter_11_1_partition, test_partition_block)
+  {
+    // Sizes around the blocks of partition_block_size at both ends, and
+    // predicates that hold for none, some and all of the elements
+    for (int n : { 0, 1, 255, 256, 257, 300, 1000, 4099 }) {
+      for (int k : { 0, 1, 10, 50, 90, 100 }) {
+        vector<int> v(n);
+        unsigned x = 12345u + unsigned(n);
+        for (int& a : v) {
+          x = x * 1103515245u + 12345u;
+          a = int((x >> 16) % 100u);
+        }
+        less_Than p { k };
+        vector<int> sorted_v = v;
+        eop::sort_n_with_buffer(sorted_v.data(), n, vector<int>(n / 2 + 1).data(), eop::less<int>());
+        int* m = eop::partition_block(v.data(), v.data() + n, p);
+        EXPECT_TRUE(eop::partitioned_at_point(v.data(), m, v.data() + n, p)) << n << " " << k;
+        EXPECT_EQ(eop::count_if(v.data(), v.data() + n, p), v.data() + n - m) << n << " " << k;
+        eop::sort_n_with_buffer(v.data(), n, vector<int>(n / 2 + 1).data(), eop::less<int>());
+        EXPECT_EQ(sorted_v, v) << n << " " << k;
+      }
+    }
+  }
+
+  TEST(chapter_11_1_partition, test_partition_unstable)
+  {
+    vector<int> v0 { 1, 2, 3, 9, 6, 7, 4, 5};
+    int* m0 = eop::partition_unstable(v0.data(), v0.data() + v0.size(), eop::is_Even<int>());
+    EXPECT_EQ(v0.data() + 5, m0);
+    EXPECT_TRUE(eop::partitioned_at_point(v0.data(), m0, v0.data() + v0.size(), eop::is_Even<int>()));
+
+    vector<int> v1(1000);
+    std::iota(begin(v1), end(v1), 0);
+    int* m1 = eop::partition_unstable(v1.data(), v1.data() + v1.size(), eop::is_Even<int>());
+    EXPECT_EQ(v1.data() + 500, m1);
+    EXPECT_TRUE(eop::partitioned_at_point(v1.data(), m1, v1.data() + v1.size(), eop::is_Even<int>()));
+  }
+
   TEST(chapter_11_1_partition, test_partition_stable_with_buffer)
   {
     vector<int> buffer(8);
@@ -2820,4 +3292,718 @@ namespace eoptest
     vector<type> expected0 {{1, 2}, {1, 1}, {2, 1}, {2, 2}};
     EXPECT_EQ(expected0, v0);
   }
+
+  struct less_tens
+  {
+    // Keys equivalent when they have the same tens, so the order of
+    // equivalent elements shows whether a merge or sort is stable
+    typedef int first_argument_type;
+    typedef int second_argument_type;
+    typedef bool result_type;
+    bool operator()(int a, int b) const { return a / 10 < b / 10; }
+  };
+
+  vector<int> sorted_stably_by_tens(const vector<int>& v)
+  {
+    list<int> l(begin(v), end(v));
+    l.sort(less_tens());
+    return vector<int>(begin(l), end(l));
+  }
+
+  TEST(chapter_11_1_partition, test_partition_three_way)
+  {
+    std::srand(41);
+    for (int n : {0, 1, 2, 3, 10, 100, 1000}) {
+      for (int c : {1, 3, 50}) {
+        vector<int> v(n);
+        for (int& x : v) x = std::rand() % c;
+        int a = c / 2;
+        vector<int> w(v);
+        auto m = eop::partition_three_way(w.data(), w.data() + n, a, std::less<int>());
+        for (int* i = w.data(); i != m.first; ++i) EXPECT_LT(*i, a);
+        for (int* i = m.first; i != m.second; ++i) EXPECT_EQ(a, *i);
+        for (int* i = m.second; i != w.data() + n; ++i) EXPECT_GT(*i, a);
+        list<int> l0(begin(v), end(v)), l1(begin(w), end(w));
+        l0.sort();
+        l1.sort();
+        EXPECT_EQ(l0, l1) << "partition_three_way is not a permutation";
+
+        list<int> l(begin(v), end(v));
+        auto ml = eop::partition_three_way_bidirectional(begin(l), end(l), a, std::less<int>());
+        EXPECT_EQ(std::distance(w.data(), m.first), std::distance(begin(l), ml.first));
+        EXPECT_EQ(std::distance(w.data(), m.second), std::distance(begin(l), ml.second));
+      }
+    }
+  }
+
+  TEST(chapter_11_1_partition, test_partition_three_way_stable_with_buffer)
+  {
+    std::srand(43);
+    for (int n : {0, 1, 2, 10, 100, 1000}) {
+      vector<int> v(n);
+      for (int& x : v) x = std::rand() % 50;
+      int a = 25;
+      // Expected: the elements of each class of tens in their order
+      vector<int> expected;
+      for (int x : v) if (x / 10 < a / 10) expected.push_back(x);
+      for (int x : v) if (x / 10 == a / 10) expected.push_back(x);
+      for (int x : v) if (a / 10 < x / 10) expected.push_back(x);
+      vector<int> b(n);
+      auto m = eop::partition_three_way_stable_with_buffer(v.data(), v.data() + n, b.data(), a, less_tens());
+      EXPECT_EQ(expected, v);
+      int m0 = 0;
+      int m1 = 0;
+      for (int x : v) {
+        m0 += x / 10 < a / 10;
+        m1 += x / 10 <= a / 10;
+      }
+      EXPECT_EQ(v.data() + m0, m.first);
+      EXPECT_EQ(v.data() + m1, m.second);
+    }
+  }
+
+  struct tens_digit
+  {
+    int operator()(int x) const { return x / 10; }
+  };
+
+  TEST(chapter_11_1_partition, test_partition_buckets_n)
+  {
+    std::srand(47);
+    for (int n : {0, 1, 2, 10, 100, 1000}) {
+      for (int k : {1, 2, 7, 40}) {
+        vector<int> v(n);
+        for (int& x : v) x = std::rand() % (10 * k);
+        vector<int> expected;
+        for (int d = 0; d < k; ++d)
+          for (int x : v) if (x / 10 == d) expected.push_back(x);
+
+        vector<int> w(v);
+        vector<int*> bounds(k + 1);
+        auto o = eop::partition_buckets_n(w.data(), n, tens_digit(), k, bounds.data());
+        EXPECT_EQ(bounds.data() + k + 1, o);
+        EXPECT_EQ(w.data(), bounds[0]);
+        EXPECT_EQ(w.data() + n, bounds[k]);
+        for (int d = 0; d < k; ++d)
+          for (int* i = bounds[d]; i != bounds[d + 1]; ++i) EXPECT_EQ(d, *i / 10);
+        list<int> l0(begin(v), end(v)), l1(begin(w), end(w));
+        l0.sort();
+        l1.sort();
+        EXPECT_EQ(l0, l1) << "partition_buckets_n is not a permutation";
+
+        vector<int> b(n);
+        vector<int*> bounds_stable(k + 1);
+        eop::partition_buckets_stable_n_with_buffer(v.data(), n, b.data(), tens_digit(), k, bounds_stable.data());
+        EXPECT_EQ(expected, v);
+        for (int d = 0; d <= k; ++d) EXPECT_EQ(bounds[d] - w.data(), bounds_stable[d] - v.data());
+      }
+    }
+  }
+
+  TEST(chapter_11_3_merging, test_merge_n_adaptive)
+  {
+    for (int n0 = 0; n0 < 20; ++n0) {
+      for (int n1 = 0; n1 < 20; ++n1) {
+        vector<int> v(n0 + n1);
+        for (int i = 0; i < n0; ++i) v[i] = (i * 7 / 3) * 10 + 1;
+        for (int i = 0; i < n1; ++i) v[n0 + i] = (i * 5 / 2) * 10 + 2;
+        vector<int> expected = sorted_stably_by_tens(v);
+        for (int n_b : {0, 1, 3, n0}) {
+          vector<int> w(v);
+          vector<int> b(n_b);
+          int* l = eop::merge_n_adaptive(w.data(), n0, w.data() + n0, n1, b.data(), n_b, less_tens());
+          EXPECT_EQ(expected, w) << n0 << " " << n1 << " " << n_b;
+          EXPECT_EQ(w.data() + n0 + n1, l);
+        }
+        vector<int> w(v);
+        eop::merge_symmetric(w.data(), w.data() + n0, w.data() + n0 + n1, less_tens());
+        EXPECT_EQ(expected, w) << n0 << " " << n1;
+        w = v;
+        eop::merge_n(w.data(), n0, w.data() + n0, n1, less_tens());
+        EXPECT_EQ(expected, w) << n0 << " " << n1;
+        w = v;
+        eop::merge_n_sqrt_buffer(w.data(), n0, w.data() + n0, n1, less_tens());
+        EXPECT_EQ(expected, w) << n0 << " " << n1;
+      }
+    }
+  }
+
+  TEST(chapter_11_3_merging, test_merge_symmetric_large)
+  {
+    std::srand(11);
+    for (int n : {100, 1000, 5000}) {
+      for (int m : {1, n / 7, n / 2, n - 1}) {
+        vector<int> v(n);
+        for (int& x : v) x = std::rand() % 2000;
+        v = vector<int>(begin(v), begin(v) + m);
+        v = sorted_stably_by_tens(v);
+        vector<int> y(n - m);
+        for (int& x : y) x = std::rand() % 2000;
+        y = sorted_stably_by_tens(y);
+        v.insert(end(v), begin(y), end(y));
+        vector<int> expected = sorted_stably_by_tens(v);
+        vector<int> w(v);
+        eop::merge_symmetric(w.data(), w.data() + m, w.data() + n, less_tens());
+        EXPECT_EQ(expected, w) << n << " " << m;
+        w = v;
+        eop::merge_n_sqrt_buffer(w.data(), m, w.data() + m, n - m, less_tens());
+        EXPECT_EQ(expected, w) << n << " " << m;
+      }
+    }
+  }
+
+  TEST(chapter_11_3_merging, test_sort_stable_n)
+  {
+    std::srand(13);
+    for (int n : {0, 1, 2, 3, 17, 64, 1000}) {
+      vector<int> v(n);
+      for (int& x : v) x = std::rand() % 500;
+      vector<int> expected = sorted_stably_by_tens(v);
+      for (int n_b : {0, 1, 8, n / 2 + 1}) {
+        vector<int> w(v);
+        vector<int> b(n_b);
+        int* l = eop::sort_n_adaptive(w.data(), n, b.data(), n_b, less_tens());
+        EXPECT_EQ(expected, w) << n << " " << n_b;
+        EXPECT_EQ(w.data() + n, l);
+      }
+      vector<int> w(v);
+      int* l = eop::sort_stable_n(w.data(), n, less_tens());
+      EXPECT_EQ(expected, w) << n;
+      EXPECT_EQ(w.data() + n, l);
+    }
+  }
+
+  template<typename F>
+  void expect_selected(vector<int> v, int k, F select_n)
+  {
+    list<int> l(begin(v), end(v));
+    l.sort();
+    vector<int> sorted(begin(l), end(l));
+    auto m = select_n(begin(v), int(v.size()), k, std::less<int>());
+    ASSERT_EQ(begin(v) + k, m);
+    EXPECT_EQ(sorted[k], source(m));
+    for (auto i = begin(v); i != m; ++i) EXPECT_FALSE(source(m) < source(i));
+    for (auto i = m; i != end(v); ++i) EXPECT_FALSE(source(i) < source(m));
+    list<int> permuted(begin(v), end(v));
+    permuted.sort();
+    EXPECT_EQ(l, permuted) << "select_n is not a permutation";
+  }
+
+  template<typename F>
+  void expect_selected_all(F select_n)
+  {
+    std::srand(7);
+    for (int n = 1; n < 64; ++n) {
+      vector<int> increasing(n);
+      std::iota(begin(increasing), end(increasing), 0);
+      vector<int> decreasing(increasing.rbegin(), increasing.rend());
+      vector<int> duplicates(n);
+      for (int& x : duplicates) x = std::rand() % 4;
+      for (int k = 0; k < n; ++k) {
+        expect_selected(increasing, k, select_n);
+        expect_selected(decreasing, k, select_n);
+        expect_selected(duplicates, k, select_n);
+      }
+    }
+    vector<int> large(5000);
+    for (int& x : large) x = std::rand() % 1000;
+    for (int k : {0, 1, 17, 2500, 4998, 4999}) expect_selected(large, k, select_n);
+    vector<int> equal(1000, 3);
+    expect_selected(equal, 500, select_n);
+  }
+
+  TEST(order_selection_n, test_select_n_median_of_medians)
+  {
+    typedef vector<int>::iterator I;
+    expect_selected_all(eop::select_n_median_of_medians<I, std::less<int>>);
+  }
+
+  TEST(order_selection_n, test_select_n_introselect)
+  {
+    typedef vector<int>::iterator I;
+    expect_selected_all(eop::select_n_introselect<I, std::less<int>>);
+  }
+
+  TEST(order_selection_n, test_select)
+  {
+    vector<int> v {5, 3, 9, 1, 7, 3, 8};
+    auto m = eop::select(begin(v), begin(v) + 3, end(v), std::less<int>());
+    EXPECT_EQ(begin(v) + 3, m);
+    EXPECT_EQ(5, source(m));
+    EXPECT_EQ(end(v), eop::select(begin(v), end(v), end(v), std::less<int>()));
+  }
+
+  vector<vector<int>> sort_inputs(int n)
+  {
+    // Random, sorted, reversed, equal, few distinct, organ pipe, sawtooth
+    // and sorted with a few elements out of place
+    vector<vector<int>> xs(8, vector<int>(n));
+    for (int i = 0; i < n; ++i) {
+      xs[0][i] = std::rand();
+      xs[1][i] = i;
+      xs[2][i] = n - i;
+      xs[3][i] = 7;
+      xs[4][i] = std::rand() % 4;
+      xs[5][i] = i < n / 2 ? i : n - i;
+      xs[6][i] = i % 37;
+      xs[7][i] = i;
+    }
+    for (int i = 0; i + 1 < n; i = i + 97) eop::exchange_values(&xs[7][i], &xs[7][n - 1 - i]);
+    return xs;
+  }
+
+  TEST(sorting, test_heap_sort_n)
+  {
+    std::srand(17);
+    for (int n : {0, 1, 2, 3, 10, 100, 1001}) {
+      for (vector<int> v : sort_inputs(n)) {
+        list<int> l(begin(v), end(v));
+        l.sort();
+        eop::heap_sort_n(v.data(), n, std::less<int>());
+        EXPECT_EQ(vector<int>(begin(l), end(l)), v) << n;
+      }
+    }
+  }
+
+  TEST(sorting, test_sort_n)
+  {
+    std::srand(19);
+    for (int n : {0, 1, 2, 5, 24, 25, 60, 127, 128, 1000, 20000}) {
+      for (vector<int> v : sort_inputs(n)) {
+        list<int> l(begin(v), end(v));
+        l.sort();
+        vector<int> expected(begin(l), end(l));
+        vector<int> w(v);
+        eop::sort_n(w.data(), n, std::less<int>());
+        EXPECT_EQ(expected, w) << n;
+        eop::sort(begin(v), end(v), std::less<int>());
+        EXPECT_EQ(expected, v) << n;
+      }
+    }
+  }
+
+  TEST(sorting, test_sort_n_heap_fallback)
+  {
+    // With no budget for unbalanced partitions the first one switches to
+    // heap sort
+    std::srand(23);
+    for (vector<int> v : sort_inputs(5000)) {
+      list<int> l(begin(v), end(v));
+      l.sort();
+      eop::sort_n_pattern_defeating(v.data(), 5000, std::less<int>(), 0, true);
+      EXPECT_EQ(vector<int>(begin(l), end(l)), v);
+    }
+  }
+
+  template<typename T>
+  void expect_radix_sorted(vector<T> v)
+  {
+    list<T> l(begin(v), end(v));
+    l.sort();
+    vector<T> expected(begin(l), end(l));
+    int n = int(v.size());
+    vector<T> w(v);
+    vector<T> b(n);
+    eop::radix_sort_lsd_n(w.data(), n, b.data(), eop::radix_identity());
+    EXPECT_EQ(expected, w) << n;
+    w = v;
+    eop::radix_sort_msd_n(w.data(), n, eop::radix_identity());
+    EXPECT_EQ(expected, w) << n;
+    eop::radix_sort_n(begin(v), n);
+    EXPECT_EQ(expected, v) << n;
+  }
+
+  TEST(sorting, test_radix_bits)
+  {
+    EXPECT_LT(eop::radix_bits(-5), eop::radix_bits(-4));
+    EXPECT_LT(eop::radix_bits(-1), eop::radix_bits(0));
+    EXPECT_LT(eop::radix_bits(-1.5f), eop::radix_bits(-0.5f));
+    EXPECT_LT(eop::radix_bits(-0.5f), eop::radix_bits(0.0f));
+    EXPECT_LT(eop::radix_bits(0.25), eop::radix_bits(1e300));
+    EXPECT_LT(eop::radix_bits(std::uint64_t(1) << 40), eop::radix_bits(~std::uint64_t(0)));
+  }
+
+  TEST(sorting, test_radix_sort_n)
+  {
+    std::srand(29);
+    for (int n : {0, 1, 2, 31, 32, 33, 300, 5000}) {
+      vector<int> a(n);
+      vector<std::uint64_t> b(n);
+      vector<float> c(n);
+      vector<double> d(n);
+      vector<int> e(n);
+      for (int i = 0; i < n; ++i) {
+        a[i] = std::rand() - RAND_MAX / 2;
+        b[i] = (std::uint64_t(std::rand()) << 33) ^ std::uint64_t(std::rand());
+        c[i] = float(std::rand() % 1000 - 500) / 8.0f;
+        d[i] = double(std::rand() - RAND_MAX / 2) * 1e10;
+        // Only the low byte varies, so the other passes are skipped
+        e[i] = 0x1000 + std::rand() % 256;
+      }
+      expect_radix_sorted(a);
+      expect_radix_sorted(b);
+      expect_radix_sorted(c);
+      expect_radix_sorted(d);
+      expect_radix_sorted(e);
+    }
+  }
+
+  struct pair_first
+  {
+    int operator()(const pair<int, int>& x) const { return x.first; }
+  };
+
+  TEST(sorting, test_radix_sort_n_key)
+  {
+    // Records sorted by a key function; the second members number the
+    // records, so the least significant digit sort is seen to be stable
+    std::srand(31);
+    int n = 3000;
+    vector<pair<int, int>> v(n);
+    for (int i = 0; i < n; ++i) v[i] = pair<int, int>(std::rand() % 100 - 50, i);
+    list<pair<int, int>> l(begin(v), end(v));
+    l.sort([](const pair<int, int>& x, const pair<int, int>& y) { return x.first < y.first; });
+    vector<pair<int, int>> expected(begin(l), end(l));
+    vector<pair<int, int>> w(v);
+    vector<pair<int, int>> b(n);
+    eop::radix_sort_lsd_n(w.data(), n, b.data(), pair_first());
+    EXPECT_EQ(expected, w);
+    eop::radix_sort_msd_n(v.data(), n, pair_first());
+    for (int i = 0; i < n; ++i) EXPECT_EQ(expected[i].first, v[i].first);
+  }
+
+  TEST(sorting, test_sort_linked_radix_n)
+  {
+    typedef slist_iterator<pair<int, int>> I;
+    std::srand(37);
+    for (int n : {0, 1, 2, 100, 2000}) {
+      eop::slist_builder<pair<int, int>> b;
+      vector<pair<int, int>> v(n);
+      for (int i = 0; i < n; ++i) {
+        v[i] = pair<int, int>(std::rand() % 1000 - 500, i);
+        b.emplace_back(v[i]);
+      }
+      eop::slist<pair<int, int>> l = b.release();
+      std::pair<I, I> p = eop::sort_linked_radix_n(l.root, n, pair_first(), eop::forward_linker<I>());
+      l.root = p.first;
+      EXPECT_TRUE(empty(p.second));
+      list<pair<int, int>> s(begin(v), end(v));
+      s.sort([](const pair<int, int>& x, const pair<int, int>& y) { return x.first < y.first; });
+      vector<pair<int, int>> w;
+      for (I i = l.root; !empty(i); i = successor(i)) w.push_back(source(i));
+      vector<pair<int, int>> expected(begin(s), end(s));
+      EXPECT_EQ(expected, w) << n;
+    }
+  }
+
+  template<typename T, typename Op>
+  void expect_scanned(const vector<T>& v, Op op, T z)
+  {
+    // Compares the scans of v against a plain loop, in a separate output
+    // and in place, serially and in parallel
+    int n = int(v.size());
+    vector<T> inclusive(n), exclusive(n);
+    T x = z;
+    for (int i = 0; i < n; ++i) {
+      exclusive[i] = x;
+      x = op(x, v[i]);
+      inclusive[i] = i == 0 ? v[0] : op(inclusive[i - 1], v[i]);
+    }
+    vector<T> w(n);
+    EXPECT_EQ(w.data() + n, eop::scan_inclusive_n(v.data(), n, w.data(), op));
+    EXPECT_EQ(inclusive, w) << n;
+    EXPECT_EQ(w.data() + n, eop::scan_exclusive_n(v.data(), n, w.data(), op, z));
+    EXPECT_EQ(exclusive, w) << n;
+    w = v;
+    eop::scan_inclusive_n(w.data(), n, w.data(), op);
+    EXPECT_EQ(inclusive, w) << n;
+    w = v;
+    eop::scan_exclusive_n(w.data(), n, w.data(), op, z);
+    EXPECT_EQ(exclusive, w) << n;
+    vector<T> y;
+    eop::scan_inclusive_n(begin(v), n, std::back_inserter(y), op);
+    EXPECT_EQ(inclusive, y) << n;
+    for (int threads : {1, 2, 3, 8}) {
+      w = v;
+      EXPECT_EQ(w.data() + n, eop::scan_inclusive_n_parallel(w.data(), n, w.data(), op, threads));
+      EXPECT_EQ(inclusive, w) << n << " " << threads;
+      w = v;
+      EXPECT_EQ(w.data() + n, eop::scan_exclusive_n_parallel(w.data(), n, w.data(), op, z, threads));
+      EXPECT_EQ(exclusive, w) << n << " " << threads;
+    }
+  }
+
+  TEST(prefix_scan, test_scan_n)
+  {
+    std::srand(53);
+    int large = 4 * eop::parallel_scan_min_size + 5;
+    for (int n : {0, 1, 3, 4, 5, 8, 13, 100, large}) {
+      vector<int> a(n);
+      vector<float> b(n);
+      vector<long> c(n);
+      for (int i = 0; i < n; ++i) {
+        a[i] = std::rand() % 2001 - 1000;
+        // Small integers, so that the sums of floats are exact in any order
+        b[i] = float(std::rand() % 21 - 10);
+        c[i] = long(std::rand()) * 3;
+      }
+      expect_scanned(a, eop::plus<int>(), 7);
+      expect_scanned(a, eop::minimum<int>(), std::numeric_limits<int>::max());
+      expect_scanned(a, eop::maximum<int>(), -2000);
+      expect_scanned(b, eop::plus<float>(), 0.5f);
+      expect_scanned(b, eop::minimum<float>(), 3.0f);
+      expect_scanned(b, eop::maximum<float>(), -std::numeric_limits<float>::infinity());
+      expect_scanned(c, eop::plus<long>(), 0L);
+    }
+  }
+
+  TEST(prefix_scan, test_scan_n_bool)
+  {
+    // The block reductions of bool are not kept in a std::vector<bool>
+    // while the threads write them; maximum is or and minimum is and
+    std::srand(59);
+    int n = 4 * eop::parallel_scan_min_size + 5;
+    // Rare values, so that the scans change inside the blocks
+    std::unique_ptr<bool[]> v(new bool[n]);
+    std::unique_ptr<bool[]> u(new bool[n]);
+    std::unique_ptr<bool[]> w(new bool[n]);
+    for (int i = 0; i < n; ++i) {
+      v[i] = std::rand() % 100000 == 0;
+      u[i] = std::rand() % 100000 != 0;
+    }
+    for (int threads : {2, 3, 8}) {
+      for (int i = 0; i < n; ++i) w[i] = v[i];
+      EXPECT_EQ(w.get() + n, eop::scan_inclusive_n_parallel(w.get(), n, w.get(), eop::maximum<bool>(), threads));
+      bool x = false;
+      for (int i = 0; i < n; ++i) {
+        x = x || v[i];
+        ASSERT_EQ(x, w[i]) << i << " " << threads;
+      }
+      EXPECT_EQ(w.get() + n, eop::scan_exclusive_n_parallel(u.get(), n, w.get(), eop::minimum<bool>(), true, threads));
+      x = true;
+      for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(x, w[i]) << i << " " << threads;
+        x = x && u[i];
+      }
+    }
+  }
+
+  TEST(chapter_5_gcd, test_gcd_binary)
+  {
+    for (int a = 0; a < 200; ++a)
+      for (int b = 0; b < 200; ++b)
+        EXPECT_EQ(eop::gcd_remainder(a, b), eop::gcd_binary(a, b)) << a << ", " << b;
+    EXPECT_EQ(6, eop::gcd(12, 18));
+    EXPECT_EQ(1ul, eop::gcd(17ul, 5ul));
+    EXPECT_EQ(1ll << 40, eop::gcd_binary(3ll << 40, 5ll << 41));
+    EXPECT_EQ(0u, eop::gcd_binary(0u, 0u));
+    // Signed arguments of either sign give the nonnegative gcd
+    EXPECT_EQ(6, eop::gcd(-12, 18));
+    EXPECT_EQ(6, eop::gcd(12, -18));
+    EXPECT_EQ(6l, eop::gcd(-12l, -18l));
+    EXPECT_EQ(5ll, eop::gcd(0ll, -5ll));
+    for (int a = -40; a < 40; ++a)
+      for (int b = -40; b < 40; ++b) {
+        int r = eop::gcd_remainder(a, b);
+        EXPECT_EQ(r < 0 ? -r : r, eop::gcd(a, b)) << a << ", " << b;
+      }
+  }
+
+  TEST(chapter_5_gcd, test_extended_gcd)
+  {
+    for (long a = 0; a < 100; ++a)
+      for (long b = 0; b < 100; ++b) {
+        auto r = eop::extended_gcd(a, b);
+        EXPECT_EQ(eop::gcd(a, b), std::get<0>(r));
+        EXPECT_EQ(std::get<0>(r), a * std::get<1>(r) + b * std::get<2>(r)) << a << ", " << b;
+      }
+  }
+
+  TEST(chapter_5_gcd, test_gcd_n)
+  {
+    vector<int> a;
+    vector<int> b;
+    for (int i = 0; i < 30; ++i)
+      for (int j = 0; j < 30; ++j) {
+        a.push_back(i * 12);
+        b.push_back(j * 18);
+      }
+    a.push_back(7); // not a multiple of the lane count
+    b.push_back(0);
+    vector<int> g(a.size());
+    auto r = eop::gcd_n(begin(a), begin(b), int(a.size()), begin(g));
+    EXPECT_EQ(end(g), std::get<2>(r));
+    for (size_t i = 0; i < a.size(); ++i)
+      EXPECT_EQ(eop::gcd_remainder(a[i], b[i]), g[i]) << a[i] << ", " << b[i];
+  }
+
+  TEST(chapter_10_4_rotate, test_rotate_with_plan)
+  {
+    for (int n = 2; n < 100; ++n)
+      for (int k = 1; k < n; ++k)
+        for (int max_block : {1, 2, 4, 64}) {
+          vector<int> v(n);
+          for (int i = 0; i < n; ++i) v[i] = i;
+          vector<int> expected = v;
+          eop::rotate_random_access_nontrivial(begin(expected), begin(expected) + (n - k), end(expected));
+          eop::rotate_plan<int> plan(n, k, max_block);
+          auto m_prime = eop::rotate_with_plan(begin(v), plan);
+          EXPECT_EQ(begin(v) + k, m_prime);
+          EXPECT_EQ(expected, v) << n << ", " << k << ", " << max_block;
+        }
+  }
+
+  TEST(chapter_10_4_rotate, test_rotate_with_plan_reused)
+  {
+    eop::rotate_plan<int> plan(12, 6, 4);
+    EXPECT_EQ(6, plan.d);
+    EXPECT_EQ(4, plan.block);
+    array<int, 12> a0 {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    array<int, 12> a1 {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    eop::rotate_with_plan(begin(a0), plan);
+    EXPECT_EQ(0, source(eop::rotate_with_plan(begin(a1), plan)));
+    EXPECT_EQ(a0, a1);
+    eop::rotate_with_plan(begin(a0), plan);
+    EXPECT_EQ(0, a0[0]);
+    EXPECT_EQ(11, a0[11]);
+  }
+
+  template<typename T>
+  void expect_reverse_n_contiguous(int n)
+  {
+    vector<T> v(n);
+    for (int i = 0; i < n; ++i) v[i] = T(i);
+    vector<T> expected(v.rbegin(), v.rend());
+    eop::reverse_n_random_access(v.data(), n);
+    EXPECT_EQ(expected, v) << n;
+    eop::reverse_n_indexed(v.data(), n);
+    std::reverse_iterator<typename vector<T>::iterator> r(end(expected));
+    EXPECT_TRUE(std::equal(begin(v), end(v), r)) << n;
+  }
+
+  struct bytes_3
+  {
+    unsigned char c[3];
+    bytes_3(int i = 0) : c{(unsigned char)i, (unsigned char)(i >> 8), 0} {}
+    bool operator==(const bytes_3& x) const { return c[0] == x.c[0] && c[1] == x.c[1] && c[2] == x.c[2]; }
+  };
+
+  struct bytes_300
+  {
+    int c[75];
+    bytes_300(int i = 0) { for (int j = 0; j < 75; ++j) c[j] = i + j; }
+    bool operator==(const bytes_300& x) const { return c[0] == x.c[0] && c[74] == x.c[74]; }
+  };
+
+  TEST(chapter_10_3_rearangements, test_reverse_n_contiguous)
+  {
+    for (int n = 0; n < 700; n = n < 80 ? n + 1 : n + 37) {
+      expect_reverse_n_contiguous<unsigned char>(n);
+      expect_reverse_n_contiguous<short>(n);
+      expect_reverse_n_contiguous<int>(n);
+      expect_reverse_n_contiguous<double>(n);
+      expect_reverse_n_contiguous<bytes_3>(n);
+      expect_reverse_n_contiguous<bytes_300>(n);
+    }
+  }
+
+  TEST(chapter_10_3_rearangements, test_reverse_n_contiguous_not_trivially_copyable)
+  {
+    vector<std::string> v {"a", "bb", "ccc", "dddd", "eeeee"};
+    eop::reverse_n_random_access(v.data(), int(v.size()));
+    vector<std::string> e_v {"eeeee", "dddd", "ccc", "bb", "a"};
+    EXPECT_EQ(e_v, v);
+  }
+
+  TEST(chapter_9_4_swap_ranges, test_reverse_swap_ranges_n_contiguous)
+  {
+    vector<unsigned char> x(1000);
+    vector<unsigned char> y(1000);
+    for (int i = 0; i < 1000; ++i) {
+      x[i] = (unsigned char)i;
+      y[i] = (unsigned char)(i * 7);
+    }
+    vector<unsigned char> e_x(x);
+    vector<unsigned char> e_y(y);
+    auto r = eop::reverse_swap_ranges_n(x.data() + 1000, y.data() + 1, 999);
+    for (int i = 0; i < 999; ++i) {
+      EXPECT_EQ(e_y[i + 1], x[999 - i]);
+      EXPECT_EQ(e_x[999 - i], y[i + 1]);
+    }
+    EXPECT_EQ(e_x[0], x[0]);
+    EXPECT_EQ(e_y[0], y[0]);
+    EXPECT_EQ(x.data() + 1, r.first);
+    EXPECT_EQ(y.data() + 1000, r.second);
+  }
+
+  TEST(chapter_9_copying, test_copy_n_contiguous)
+  {
+    vector<int> x {0, 1, 2, 3, 4, 5, 6, 7};
+    vector<int> y(8);
+    const int* f = x.data();
+    auto r = eop::copy_n(f, 8, y.data());
+    EXPECT_EQ(x.data() + 8, r.first);
+    EXPECT_EQ(y.data() + 8, r.second);
+    EXPECT_EQ(x, y);
+    // A forward copy may overlap with the output before the input
+    eop::copy_n(x.data() + 2, 6, x.data());
+    vector<int> e_x {2, 3, 4, 5, 6, 7, 6, 7};
+    EXPECT_EQ(e_x, x);
+    auto r_b = eop::copy_bounded(y.data(), y.data() + 8, x.data(), x.data() + 3);
+    EXPECT_EQ(y.data() + 3, r_b.first);
+    EXPECT_EQ(x.data() + 3, r_b.second);
+    vector<std::string> s {"a", "b", "c"};
+    vector<std::string> t(3);
+    eop::copy_n(s.data(), 3, t.data());
+    EXPECT_EQ(s, t);
+  }
+
+  TEST(chapter_9_copying, test_copy_backward_n_contiguous)
+  {
+    vector<int> x {0, 1, 2, 3, 4, 5, 6, 7};
+    // A backward copy may overlap with the output after the input
+    auto r = eop::copy_backward_n(x.data() + 6, 6, x.data() + 8);
+    EXPECT_EQ(x.data(), r.first);
+    EXPECT_EQ(x.data() + 2, r.second);
+    vector<int> e_x {0, 1, 0, 1, 2, 3, 4, 5};
+    EXPECT_EQ(e_x, x);
+  }
+
+  TEST(chapter_9_copying, test_copy_n_streaming)
+  {
+    const int n = int(eop::streaming_copy_threshold_bytes / sizeof(int)) + 1001;
+    vector<int> x(n + 1);
+    for (int i = 0; i < n + 1; ++i) x[i] = i;
+    vector<int> y(n + 3);
+    auto r = eop::copy_n_streaming(x.data() + 1, n, y.data() + 3);
+    EXPECT_EQ(x.data() + n + 1, r.first);
+    EXPECT_EQ(y.data() + n + 3, r.second);
+    EXPECT_EQ(0, y[2]);
+    EXPECT_TRUE(std::equal(begin(x) + 1, end(x), begin(y) + 3));
+    vector<int> z(n + 2);
+    auto r_b = eop::copy_backward_n_streaming(y.data() + n + 3, n, z.data() + n + 1);
+    EXPECT_EQ(y.data() + 3, r_b.first);
+    EXPECT_EQ(z.data() + 1, r_b.second);
+    EXPECT_EQ(0, z[n + 1]);
+    EXPECT_TRUE(std::equal(begin(x) + 1, end(x), begin(z) + 1));
+  }
+
+  TEST(chapter_9_4_swap_ranges, test_swap_ranges_n_contiguous)
+  {
+    const int n = int(eop::streaming_copy_threshold_bytes / sizeof(int)) + 5;
+    for (int offset : {0, 1}) {
+      vector<int> x(n, 1);
+      vector<int> y(n + 1, 2);
+      auto r = eop::swap_ranges_n_streaming(x.data(), y.data() + offset, n);
+      EXPECT_EQ(x.data() + n, r.first);
+      EXPECT_EQ(y.data() + offset + n, r.second);
+      EXPECT_EQ(vector<int>(n, 2), x);
+      EXPECT_EQ(offset == 0 ? 1 : 2, y[0]);
+      EXPECT_EQ(1, y[n - 1]);
+      r = eop::swap_ranges_n(x.data(), y.data() + offset, 3);
+      EXPECT_EQ(x.data() + 3, r.first);
+      EXPECT_EQ(1, x[2]);
+      EXPECT_EQ(2, x[3]);
+    }
+  }
 }
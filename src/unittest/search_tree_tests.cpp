@@ -0,0 +1,147 @@
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "intrinsics.h"
+#include "search_tree.h"
+
+namespace eoptest {
+	typedef eop::search_tree<int> Set;
+	typedef eop::weighted_tree_coordinate<int> C;
+
+	// Checks the order, links, kept weights and the AVL balance of every node
+	template<typename T, typename R>
+	void expect_search_tree(eop::search_tree<T, R> const& x)
+	{
+		typedef eop::weighted_tree_coordinate<T> C;
+		if (eop::empty(x.root)) return;
+		EXPECT_FALSE(eop::has_predecessor(x.root));
+		std::vector<C> stack{ x.root };
+		while (!stack.empty()) {
+			C c = stack.back();
+			stack.pop_back();
+			EXPECT_EQ(eop::weight_recursive(c), eop::weight(c));
+			EXPECT_EQ(eop::height_recursive(c), eop::height(c));
+			int b = eop::height(eop::left_successor(c)) - eop::height(eop::right_successor(c));
+			EXPECT_TRUE(-1 <= b && b <= 1);
+			for (C s : { eop::left_successor(c), eop::right_successor(c) }) {
+				if (eop::empty(s)) continue;
+				EXPECT_EQ(c, eop::predecessor(s));
+				stack.push_back(s);
+			}
+		}
+		auto f = begin(x);
+		auto l = end(x);
+		if (f == l) return;
+		R r = x.r;
+		auto n = f;
+		while (++n != l) {
+			EXPECT_TRUE(r(*f, *n));
+			f = n;
+		}
+	}
+
+	TEST(search_tree_tests, test_insert)
+	{
+		Set x;
+		EXPECT_TRUE(eop::empty(x));
+		EXPECT_TRUE(begin(x) == end(x));
+		for (int i = 0; i < 100; ++i) {
+			auto p = insert(x, i);
+			EXPECT_TRUE(p.second);
+			EXPECT_EQ(i, eop::source(p.first));
+		}
+		expect_search_tree(x);
+		EXPECT_EQ(100, size(x));
+		EXPECT_EQ(7, eop::height(x.root));
+		auto p = insert(x, 42);
+		EXPECT_FALSE(p.second);
+		EXPECT_EQ(42, eop::source(p.first));
+		EXPECT_EQ(100, size(x));
+		std::vector<int> v(begin(x), end(x));
+		for (int i = 0; i < 100; ++i) EXPECT_EQ(i, v[i]);
+	}
+
+	TEST(search_tree_tests, test_lookup)
+	{
+		Set x;
+		for (int i = 0; i < 50; ++i) insert(x, 2 * i);
+		EXPECT_EQ(10, eop::source(lower_bound(x, 10)));
+		EXPECT_EQ(12, eop::source(lower_bound(x, 11)));
+		EXPECT_EQ(12, eop::source(upper_bound(x, 10)));
+		EXPECT_EQ(0, eop::source(lower_bound(x, -5)));
+		EXPECT_TRUE(eop::empty(lower_bound(x, 99)));
+		EXPECT_TRUE(eop::empty(upper_bound(x, 98)));
+		EXPECT_EQ(20, eop::source(find(x, 20)));
+		EXPECT_TRUE(eop::empty(find(x, 21)));
+		for (int k = 0; k < 50; ++k) EXPECT_EQ(2 * k, eop::source(select(x, k)));
+		// Iterating from a node found
+		std::vector<int> v(iterator_at(x, lower_bound(x, 91)), end(x));
+		EXPECT_EQ((std::vector<int>{ 92, 94, 96, 98 }), v);
+	}
+
+	TEST(search_tree_tests, test_erase)
+	{
+		Set x;
+		for (int i = 0; i < 64; ++i) insert(x, i);
+		// A leaf, a node with one successor, nodes with two and the root
+		for (int i : { 63, 62, 5, 31, 0, 16 }) {
+			EXPECT_TRUE(erase(x, i));
+			EXPECT_FALSE(erase(x, i));
+			expect_search_tree(x);
+		}
+		EXPECT_EQ(58, size(x));
+		while (!eop::empty(x)) erase(x, x.root);
+		EXPECT_TRUE(begin(x) == end(x));
+		// Freed nodes are reused
+		insert(x, 1);
+		EXPECT_EQ(1u, x.pool.slabs.size());
+	}
+
+	TEST(search_tree_tests, test_random_against_std_set)
+	{
+		Set x;
+		std::set<int> s;
+		std::mt19937 g(7);
+		std::uniform_int_distribution<int> d(0, 499);
+		for (int i = 0; i < 5000; ++i) {
+			int a = d(g);
+			if (g() % 3 == 0) EXPECT_EQ(s.erase(a) == 1, erase(x, a));
+			else EXPECT_EQ(s.insert(a).second, insert(x, a).second);
+			if (i % 500 == 0) expect_search_tree(x);
+		}
+		expect_search_tree(x);
+		EXPECT_EQ(std::vector<int>(s.begin(), s.end()), std::vector<int>(begin(x), end(x)));
+	}
+
+	TEST(search_tree_tests, test_pool_slab_size)
+	{
+		// A slab size of zero is taken as one node per slab
+		eop::weighted_tree_pool<int> pool(0);
+		C a = pool.allocate(1);
+		C b = pool.allocate(2);
+		EXPECT_EQ(2u, pool.slabs.size());
+		EXPECT_EQ(1, eop::source(a));
+		EXPECT_EQ(2, eop::source(b));
+		pool.deallocate(a);
+		pool.deallocate(b);
+	}
+
+	struct greater_string
+	{
+		typedef std::string first_argument_type;
+		bool operator()(const std::string& a, const std::string& b) const { return b < a; }
+	};
+
+	TEST(search_tree_tests, test_relation)
+	{
+		eop::search_tree<std::string, greater_string> x;
+		for (auto s : { "fig", "apple", "pear", "kiwi", "apple" }) insert(x, std::string(s));
+		expect_search_tree(x);
+		EXPECT_EQ((std::vector<std::string>{ "pear", "kiwi", "fig", "apple" }),
+		          std::vector<std::string>(begin(x), end(x)));
+		EXPECT_EQ("fig", eop::source(lower_bound(x, std::string("grape"))));
+	}
+} // namespace eoptest
@@ -0,0 +1,122 @@
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "segment_tree.h"
+
+namespace eoptest {
+	// Concatenation is associative but neither commutative nor invertible,
+	// so the reduction shows the order in which the values are combined
+	typedef eop::plus<std::string> concatenate;
+
+	template<typename T, typename Op>
+	T reduce_vector(const std::vector<T>& x, std::size_t i, std::size_t j, Op op, T z)
+	{
+		while (i != j) z = op(z, x[i++]);
+		return z;
+	}
+
+	TEST(segment_tree_tests, test_empty)
+	{
+		eop::segment_tree<concatenate> x(concatenate(), "");
+		EXPECT_EQ(0u, eop::size(x));
+		EXPECT_EQ("", eop::reduce(x, 0, 0));
+		eop::segment_tree<concatenate> y(concatenate(), "", 5);
+		EXPECT_EQ(5u, eop::size(y));
+		EXPECT_EQ("", eop::reduce(y, 0, 5));
+		eop::fenwick_tree<eop::plus<int>, eop::negate<int>> w(eop::plus<int>(), eop::negate<int>(), 0);
+		EXPECT_EQ(0u, eop::size(w));
+		EXPECT_EQ(0, eop::reduce(w, 0, 0));
+	}
+
+	TEST(segment_tree_tests, test_segment_tree)
+	{
+		// Every range of every size up to 40 after building, then random
+		// updates and ranges
+		std::mt19937 g(7);
+		for (std::size_t n = 0; n <= 40; ++n) {
+			std::vector<std::string> v(n);
+			for (std::size_t i = 0; i < n; ++i) v[i] = std::string(1, char('a' + i % 26));
+			eop::segment_tree<concatenate> x(concatenate(), "");
+			EXPECT_EQ(v.end(), eop::build_n(x, v.begin(), int(n)));
+			ASSERT_EQ(n, eop::size(x));
+			for (std::size_t i = 0; i <= n; ++i)
+				for (std::size_t j = i; j <= n; ++j)
+					ASSERT_EQ(reduce_vector(v, i, j, concatenate(), std::string()), eop::reduce(x, i, j)) << n << " " << i << " " << j;
+			for (int k = 0; n != 0 && k < 200; ++k) {
+				std::size_t i = g() % n;
+				v[i] = std::string(1 + g() % 2, char('A' + g() % 26));
+				eop::update(x, i, v[i]);
+				ASSERT_EQ(v[i], eop::value(x, i));
+				std::size_t j = g() % (n + 1);
+				std::size_t l = j + g() % (n + 1 - j);
+				ASSERT_EQ(reduce_vector(v, j, l, concatenate(), std::string()), eop::reduce(x, j, l)) << n << " " << k;
+			}
+		}
+	}
+
+	TEST(segment_tree_tests, test_segment_tree_minimum)
+	{
+		std::mt19937 g(11);
+		std::vector<int> v(1000);
+		for (int& a : v) a = int(g() % 100000);
+		eop::segment_tree<eop::minimum<int>> x(eop::minimum<int>(), std::numeric_limits<int>::max());
+		eop::build_n(x, v.data(), int(v.size()));
+		for (int k = 0; k < 2000; ++k) {
+			std::size_t i = g() % v.size();
+			v[i] = int(g() % 100000);
+			eop::update(x, i, v[i]);
+			std::size_t j = g() % (v.size() + 1);
+			std::size_t l = j + g() % (v.size() + 1 - j);
+			ASSERT_EQ(reduce_vector(v, j, l, eop::minimum<int>(), std::numeric_limits<int>::max()), eop::reduce(x, j, l)) << k;
+		}
+	}
+
+	TEST(segment_tree_tests, test_fenwick_tree)
+	{
+		std::mt19937 g(13);
+		typedef eop::fenwick_tree<eop::plus<long long>, eop::negate<long long>> F;
+		for (std::size_t n = 0; n <= 40; ++n) {
+			std::vector<long long> v(n);
+			for (long long& a : v) a = (long long)(g() % 2001) - 1000;
+			F x(eop::plus<long long>(), eop::negate<long long>(), 0);
+			EXPECT_EQ(v.end(), eop::build_n(x, v.begin(), int(n)));
+			ASSERT_EQ(n, eop::size(x));
+			for (std::size_t i = 0; i <= n; ++i) {
+				ASSERT_EQ(reduce_vector(v, 0, i, eop::plus<long long>(), 0LL), eop::reduce_prefix(x, i));
+				for (std::size_t j = i; j <= n; ++j)
+					ASSERT_EQ(reduce_vector(v, i, j, eop::plus<long long>(), 0LL), eop::reduce(x, i, j)) << n << " " << i << " " << j;
+			}
+			for (int k = 0; n != 0 && k < 200; ++k) {
+				std::size_t i = g() % n;
+				long long a = (long long)(g() % 2001) - 1000;
+				if (k % 2 == 0) {
+					v[i] = v[i] + a;
+					eop::add(x, i, a);
+				} else {
+					v[i] = a;
+					eop::update(x, i, a);
+				}
+				std::size_t j = g() % (n + 1);
+				std::size_t l = j + g() % (n + 1 - j);
+				ASSERT_EQ(reduce_vector(v, j, l, eop::plus<long long>(), 0LL), eop::reduce(x, j, l)) << n << " " << k;
+			}
+		}
+	}
+
+	TEST(segment_tree_tests, test_fenwick_tree_built_by_add)
+	{
+		// Building from a range gives the same nodes as adding each value
+		std::mt19937 g(17);
+		std::vector<int> v(100);
+		for (int& a : v) a = int(g() % 1000);
+		typedef eop::fenwick_tree<eop::plus<int>, eop::negate<int>> F;
+		F x(eop::plus<int>(), eop::negate<int>(), 0);
+		eop::build_n(x, v.data(), int(v.size()));
+		F y(eop::plus<int>(), eop::negate<int>(), 0, v.size());
+		for (std::size_t i = 0; i < v.size(); ++i) eop::add(y, i, v[i]);
+		EXPECT_EQ(y.nodes, x.nodes);
+	}
+}
@@ -0,0 +1,74 @@
+#include <deque>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sliding_window.h"
+
+namespace eoptest {
+	// Concatenation is associative but neither commutative nor invertible,
+	// so the reduction shows the order in which the values are combined
+	typedef eop::plus<std::string> concatenate;
+
+	template<typename Op>
+	typename Op::first_argument_type reduce_deque(const std::deque<typename Op::first_argument_type>& x, Op op, typename Op::first_argument_type z)
+	{
+		for (auto const& a : x) z = op(z, a);
+		return z;
+	}
+
+	TEST(sliding_window_tests, test_empty)
+	{
+		eop::sliding_window<concatenate> w(concatenate(), "");
+		EXPECT_TRUE(eop::empty(w));
+		EXPECT_EQ(0u, eop::size(w));
+		EXPECT_EQ("", eop::reduce(w));
+		eop::push_back(w, "a");
+		eop::pop_front(w);
+		EXPECT_TRUE(eop::empty(w));
+		EXPECT_EQ("", eop::reduce(w));
+	}
+
+	TEST(sliding_window_tests, test_push_back_pop_front)
+	{
+		// Random pushes and pops, growing the window past its capacity
+		std::mt19937 g(3);
+		eop::sliding_window<concatenate> w(concatenate(), "", 2);
+		std::deque<std::string> x;
+		int next = 0;
+		for (int i = 0; i < 5000; ++i) {
+			bool push = x.empty() || g() % 8 < (i < 2500 ? 5u : 3u);
+			if (push) {
+				std::string a(1, char('a' + next % 26));
+				next = next + 1;
+				eop::push_back(w, a);
+				x.push_back(a);
+			} else {
+				eop::pop_front(w);
+				x.pop_front();
+			}
+			ASSERT_EQ(x.size(), eop::size(w));
+			ASSERT_EQ(reduce_deque(x, concatenate(), std::string()), eop::reduce(w)) << i;
+		}
+	}
+
+	TEST(sliding_window_tests, test_reduce_windows_n)
+	{
+		std::mt19937 g(5);
+		std::vector<int> v(1000);
+		for (int& a : v) a = int(g() % 10000) - 5000;
+		for (int k : { 1, 2, 7, 64, 1000, 2000 }) {
+			std::vector<int> y(v.size());
+			auto o = eop::reduce_windows_n(v.data(), int(v.size()), k, y.data(),
+			                               eop::minimum<int>(), std::numeric_limits<int>::max());
+			EXPECT_EQ(y.data() + v.size(), o);
+			for (int i = 0; i < int(v.size()); ++i) {
+				int m = std::numeric_limits<int>::max();
+				for (int j = i < k ? 0 : i - k + 1; j <= i; ++j) m = m < v[j] ? m : v[j];
+				ASSERT_EQ(m, y[i]) << k << " " << i;
+			}
+		}
+	}
+}
@@ -1,4 +1,6 @@
 
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "intrinsics.h"
 #include "tree.h"
@@ -16,4 +18,111 @@ namespace eoptest {
 		eop::tree_coordinate<int> c{ 0 };
 		EXPECT_TRUE(eop::empty(c));
 	}
+
+	typedef eop::weighted_tree<int> WTree;
+	typedef eop::weighted_tree_coordinate<int> WCoordinate;
+
+	// A complete tree over [f, l) in order
+	WTree create_weighted_tree(int f, int l)
+	{
+		if (f == l) return WTree{};
+		int m = f + (l - f) / 2;
+		return WTree{ m, create_weighted_tree(f, m), create_weighted_tree(m + 1, l) };
+	}
+
+	// Checks the kept weight and height of every node against recomputed ones
+	void expect_weight_height(WCoordinate c)
+	{
+		if (eop::empty(c)) return;
+		EXPECT_EQ(eop::weight_recursive(c), eop::weight(c)) << eop::source(c);
+		EXPECT_EQ(eop::height_recursive(c), eop::height(c)) << eop::source(c);
+		if (eop::has_left_successor(c)) {
+			EXPECT_EQ(c, eop::predecessor(eop::left_successor(c)));
+			expect_weight_height(eop::left_successor(c));
+		}
+		if (eop::has_right_successor(c)) {
+			EXPECT_EQ(c, eop::predecessor(eop::right_successor(c)));
+			expect_weight_height(eop::right_successor(c));
+		}
+	}
+
+	std::vector<int> in_order(WCoordinate c)
+	{
+		std::vector<int> v;
+		for (int k = 0; k < eop::weight(c); ++k) v.push_back(eop::source(eop::in_order_select(c, k)));
+		return v;
+	}
+
+	TEST(weighted_tree_tests, test_construct)
+	{
+		WTree e;
+		EXPECT_EQ(0, eop::weight(begin(e)));
+		EXPECT_EQ(0, eop::height(begin(e)));
+		WTree t = create_weighted_tree(0, 100);
+		EXPECT_EQ(100, eop::weight(begin(t)));
+		EXPECT_EQ(7, eop::height(begin(t)));
+		expect_weight_height(begin(t));
+		WTree u{ -1, t, WTree{ 100 } };
+		EXPECT_EQ(102, eop::weight(begin(u)));
+		EXPECT_EQ(8, eop::height(begin(u)));
+		expect_weight_height(begin(u));
+	}
+
+	TEST(weighted_tree_tests, test_in_order_select_and_rank)
+	{
+		WTree t = create_weighted_tree(0, 100);
+		for (int k = 0; k < 100; ++k) {
+			WCoordinate c = eop::in_order_select(begin(t), k);
+			EXPECT_EQ(k, eop::source(c));
+			EXPECT_EQ(k, eop::in_order_rank(c));
+		}
+		// Within a subtree
+		WCoordinate r = eop::right_successor(begin(t));
+		EXPECT_EQ(51, eop::source(eop::in_order_select(r, 0)));
+	}
+
+	TEST(weighted_tree_tests, test_rotate)
+	{
+		WTree t = create_weighted_tree(0, 31);
+		std::vector<int> expected = in_order(begin(t));
+		// A rotation below the root carries the new heights up
+		WCoordinate c = eop::left_successor(begin(t));
+		c = eop::rotate_right(c);
+		EXPECT_EQ(3, eop::source(c));
+		EXPECT_EQ(6, eop::height(begin(t)));
+		expect_weight_height(begin(t));
+		EXPECT_EQ(expected, in_order(begin(t)));
+		c = eop::rotate_left(c);
+		EXPECT_EQ(7, eop::source(c));
+		EXPECT_EQ(5, eop::height(begin(t)));
+		expect_weight_height(begin(t));
+		// Rotating the root
+		t.root = eop::rotate_left(begin(t));
+		EXPECT_FALSE(eop::has_predecessor(begin(t)));
+		EXPECT_EQ(23, eop::source(begin(t)));
+		expect_weight_height(begin(t));
+		EXPECT_EQ(expected, in_order(begin(t)));
+	}
+
+	TEST(weighted_tree_tests, test_update_weight_height)
+	{
+		WTree t = create_weighted_tree(0, 7);
+		WCoordinate leaf = eop::in_order_select(begin(t), 6);
+		WCoordinate x = eop::weighted_tree_node_construct<int>{}(7,
+			eop::weighted_tree_node_construct<int>{}(8), WCoordinate{});
+		eop::set_right_successor(leaf, x);
+		eop::set_predecessor(x, leaf);
+		eop::update_weight_height(eop::predecessor(leaf));
+		EXPECT_EQ(9, eop::weight(begin(t)));
+		EXPECT_EQ(5, eop::height(begin(t)));
+		expect_weight_height(begin(t));
+	}
+
+	TEST(weighted_tree_tests, test_traverse_rotating)
+	{
+		WTree t = create_weighted_tree(0, 50);
+		EXPECT_EQ(50, eop::weight_rotating(begin(t)));
+		expect_weight_height(begin(t));
+		EXPECT_EQ(in_order(begin(create_weighted_tree(0, 50))), in_order(begin(t)));
+	}
 } // namespace eoptest